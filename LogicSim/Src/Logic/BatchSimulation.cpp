@@ -0,0 +1,31 @@
+#include "BatchSimulation.h"
+
+BatchSimulation::BatchSimulation(const Netlist& netlist, std::size_t instanceCount, std::size_t words)
+    : m_Netlist(netlist)
+{
+	m_Instances.reserve(instanceCount);
+	for (std::size_t i = 0; i < instanceCount; ++i)
+		m_Instances.emplace_back(netlist, words);
+}
+
+void BatchSimulation::tick()
+{
+	resizeScratch(1);
+	for (auto& instance : m_Instances)
+		instance.tick(m_Scratch[0]);
+}
+
+void BatchSimulation::tick(ThreadPool& pool)
+{
+	forEach(pool, [](std::size_t, PatternState& instance, PatternState::Scratch& scratch) { instance.tick(scratch); });
+}
+
+void BatchSimulation::resizeScratch(std::size_t workers)
+{
+	// Every instance has the same netlist and word count, so any of them sizes the scratch
+	if (m_Instances.empty())
+		return;
+	m_Scratch.reserve(workers);
+	while (m_Scratch.size() < workers)
+		m_Scratch.push_back(m_Instances[0].newScratch());
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Netlist.h"
+#include "PatternState.h"
+#include "Utils/ThreadPool.h"
+
+#include <type_traits>
+#include <vector>
+
+// Many independent simulations of the same circuit, e.g. fault campaigns or per configuration stimuli.
+// Every instance is a PatternState over the one shared, immutable Netlist, so an instance only owns its connection words.
+// Table and gate scratch buffers belong to the batch, one per worker, instead of to every instance.
+// Instances are distributed over a ThreadPool with work stealing, so uneven per instance work still keeps every worker busy.
+struct BatchSimulation
+{
+public:
+	// Instances claimed per steal, small enough to balance and large enough to amortize the claim
+	static constexpr std::size_t c_Grain = 4;
+
+public:
+	BatchSimulation(const Netlist& netlist, std::size_t instanceCount, std::size_t words = 1);
+
+	// Ticks every instance once
+	void tick();
+	void tick(ThreadPool& pool);
+
+	// Calls function(index, instance) for every instance in parallel, e.g. to apply stimuli, tick and collect outputs in a single pass.
+	// A function taking function(index, instance, scratch) also receives the scratch of the calling worker, to tick with instance.tick(scratch)
+	template <class F>
+	void forEach(ThreadPool& pool, F&& function)
+	{
+		resizeScratch(pool.workerCount());
+		auto forRange = [this, &function](std::size_t begin, std::size_t end, std::size_t worker)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				if constexpr (std::is_invocable_v<F&, std::size_t, PatternState&, PatternState::Scratch&>)
+					function(i, m_Instances[i], m_Scratch[worker]);
+				else
+					function(i, m_Instances[i]);
+			}
+		};
+		pool.parallelForDynamic(m_Instances.size(), c_Grain, forRange);
+	}
+
+	std::size_t instanceCount() const { return m_Instances.size(); }
+
+	auto& getNetlist() const { return m_Netlist; }
+	auto& getInstance(std::size_t index) { return m_Instances[index]; }
+	auto& getInstance(std::size_t index) const { return m_Instances[index]; }
+	auto& getInstances() { return m_Instances; }
+	auto& getInstances() const { return m_Instances; }
+
+	std::size_t allocatedSizeOf() const
+	{
+		std::size_t size = m_Instances.capacity() * sizeof(PatternState) + m_Scratch.capacity() * sizeof(PatternState::Scratch);
+		for (auto& instance : m_Instances)
+			size += instance.allocatedSizeOf();
+		for (auto& scratch : m_Scratch)
+			size += scratch.allocatedSizeOf();
+		return size;
+	}
+
+	std::size_t totalSizeOf() const
+	{
+		return sizeof(*this) + allocatedSizeOf();
+	}
+
+private:
+	void resizeScratch(std::size_t workers);
+
+private:
+	const Netlist&                     m_Netlist;
+	std::vector<PatternState>          m_Instances;
+	std::vector<PatternState::Scratch> m_Scratch;
+};
\ No newline at end of file
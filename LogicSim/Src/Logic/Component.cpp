@@ -1 +1,67 @@
 #include "Component.h"
+#include "Netlist.h"
+#include "RevisionSet.h"
+#include "TruthTableCache.h"
+
+void Component::compileGraph(TruthTableCache* cache, ThreadPool* pool)
+{
+	if (!m_Graph)
+		return;
+
+	dropCompiled();
+	if (m_TruthTable || m_ConeTable || m_DecisionDiagram)
+		return;
+
+	m_CompileRequested = true;
+	m_Compiled         = true;
+	m_CompiledRevision = m_Graph->revision();
+	m_Version          = NextVersion();
+
+	// A table can't capture state, so sequential graphs are left to GraphState
+	Netlist netlist { *m_Graph };
+	auto&   schedule = netlist.getSchedule();
+	if (schedule.feedbackBegin() != schedule.feedbackEnd())
+		return;
+
+	if (m_Graph->compilable())
+	{
+		std::optional<TruthTable> truthTable;
+		if (pool)
+			truthTable = cache ? cache->compile(*m_Graph, *pool) : m_Graph->compile(*pool);
+		else
+			truthTable = cache ? cache->compile(*m_Graph) : m_Graph->compile();
+		m_TruthTable = new TruthTable { std::move(*truthTable) };
+		return;
+	}
+
+	ConeTable cones = pool ? m_Graph->compileCones(*pool) : m_Graph->compileCones();
+	if (cones.valid())
+	{
+		m_ConeTable = new ConeTable { std::move(cones) };
+		return;
+	}
+
+	DecisionDiagram diagram { netlist };
+	if (diagram.valid())
+		m_DecisionDiagram = new DecisionDiagram { std::move(diagram) };
+}
+
+void Component::dropCompiled()
+{
+	if (!m_Compiled)
+		return;
+
+	delete m_TruthTable;
+	delete m_ConeTable;
+	delete m_DecisionDiagram;
+	m_TruthTable      = nullptr;
+	m_ConeTable       = nullptr;
+	m_DecisionDiagram = nullptr;
+	m_Compiled        = false;
+	m_Version         = NextVersion();
+}
+
+std::uint64_t Component::NextVersion()
+{
+	return RevisionSet::NextRevision();
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "ConeTable.h"
+#include "DecisionDiagram.h"
+#include "Gate.h"
 #include "Graph.h"
 #include "TruthTable.h"
 #include "Utils/Flags.h"
@@ -44,14 +47,23 @@ constexpr NamespaceName operator""_nn(const char* str, std::size_t len)
 	return NamespaceName { std::string_view { str, len } };
 }
 
+struct TruthTableCache;
+
 struct Component
 {
 public:
 	template <Callable<void, std::vector<std::string>&, std::vector<std::string>&> F>
 	Component(NamespaceName name, F&& portNameFiller)
 	    : m_Name(std::move(name)),
+	      m_Gate(GateOp::Table),
 	      m_TruthTable(nullptr),
-	      m_Graph(nullptr)
+	      m_ConeTable(nullptr),
+	      m_DecisionDiagram(nullptr),
+	      m_Graph(nullptr),
+	      m_CompileRequested(false),
+	      m_Compiled(false),
+	      m_CompiledRevision(0),
+	      m_Version(NextVersion())
 	{
 		portNameFiller(m_InputNames, m_OutputNames);
 	}
@@ -60,27 +72,47 @@ public:
 	    : m_Name(std::move(move.m_Name)),
 	      m_InputNames(std::move(move.m_InputNames)),
 	      m_OutputNames(std::move(move.m_OutputNames)),
+	      m_Gate(move.m_Gate),
 	      m_TruthTable(move.m_TruthTable),
-	      m_Graph(move.m_Graph)
+	      m_ConeTable(move.m_ConeTable),
+	      m_DecisionDiagram(move.m_DecisionDiagram),
+	      m_Graph(move.m_Graph),
+	      m_CompileRequested(move.m_CompileRequested),
+	      m_Compiled(move.m_Compiled),
+	      m_CompiledRevision(move.m_CompiledRevision),
+	      m_Version(move.m_Version)
 	{
-		move.m_TruthTable = nullptr;
-		move.m_Graph      = nullptr;
+		move.m_TruthTable      = nullptr;
+		move.m_ConeTable       = nullptr;
+		move.m_DecisionDiagram = nullptr;
+		move.m_Graph           = nullptr;
 	}
 	Component& operator=(const Component& copy) = delete;
 	Component& operator=(Component&& move) noexcept
 	{
-		m_Name            = std::move(move.m_Name);
-		m_InputNames      = std::move(move.m_InputNames);
-		m_OutputNames     = std::move(move.m_OutputNames);
-		m_TruthTable      = move.m_TruthTable;
-		m_Graph           = move.m_Graph;
-		move.m_TruthTable = nullptr;
-		move.m_Graph      = nullptr;
+		m_Name                 = std::move(move.m_Name);
+		m_InputNames           = std::move(move.m_InputNames);
+		m_OutputNames          = std::move(move.m_OutputNames);
+		m_Gate                 = move.m_Gate;
+		m_TruthTable           = move.m_TruthTable;
+		m_ConeTable            = move.m_ConeTable;
+		m_DecisionDiagram      = move.m_DecisionDiagram;
+		m_Graph                = move.m_Graph;
+		m_CompileRequested     = move.m_CompileRequested;
+		m_Compiled             = move.m_Compiled;
+		m_CompiledRevision     = move.m_CompiledRevision;
+		m_Version              = move.m_Version;
+		move.m_TruthTable      = nullptr;
+		move.m_ConeTable       = nullptr;
+		move.m_DecisionDiagram = nullptr;
+		move.m_Graph           = nullptr;
 		return *this;
 	}
 	~Component()
 	{
 		delete m_TruthTable;
+		delete m_ConeTable;
+		delete m_DecisionDiagram;
 		delete m_Graph;
 	}
 
@@ -94,12 +126,83 @@ public:
 		}
 
 		TruthTable temp = truthTableProvider();
-		if (temp.inputCount() != inputCount() && temp.outputCount() != outputCount())
+		if (temp.inputCount() != inputCount() || temp.outputCount() != outputCount())
 		{
 			Log::Warn("Trying to set truth table with incorrect input and output count, received {}/{}, requires {}/{}", temp.inputCount(), temp.outputCount(), inputCount(), outputCount());
 			return;
 		}
 		m_TruthTable = new TruthTable { std::move(temp) };
+		m_Version    = NextVersion();
+	}
+
+	// Primitive gates are evaluated directly from their packed inputs, a truth table is still built for introspection when none is set
+	void setGate(GateOp op)
+	{
+		if (m_Gate != GateOp::Table)
+		{
+			Log::Warn("Trying to override gate for component {}:{};{}", m_Name.m_Namespace, m_Name.m_Name, inputCount());
+			return;
+		}
+		if (op == GateOp::Table || outputCount() != 1 || inputCount() < 1 || inputCount() > 64 || (op == GateOp::Buffer && inputCount() != 1))
+		{
+			Log::Warn("Trying to set gate with incorrect input and output count, received {}/{}", inputCount(), outputCount());
+			return;
+		}
+
+		m_Gate    = op;
+		m_Version = NextVersion();
+		if (!m_TruthTable && inputCount() <= 16)
+			m_TruthTable = new TruthTable { GateTruthTable(op, static_cast<std::uint8_t>(inputCount())) };
+	}
+
+	// Per output cone tables, usually provided by Graph::compileCones
+	template <Callable<ConeTable> F>
+	void setConeTable(F&& coneTableProvider)
+	{
+		if (m_ConeTable)
+		{
+			Log::Warn("Trying to override cone table for component {}:{};{}", m_Name.m_Namespace, m_Name.m_Name, inputCount());
+			return;
+		}
+
+		ConeTable temp = coneTableProvider();
+		if (!temp.valid())
+		{
+			Log::Warn("Trying to set an incomplete cone table for component {}:{};{}", m_Name.m_Namespace, m_Name.m_Name, inputCount());
+			return;
+		}
+		if (temp.inputCount() != inputCount() || temp.outputCount() != outputCount())
+		{
+			Log::Warn("Trying to set cone table with incorrect input and output count, received {}/{}, requires {}/{}", temp.inputCount(), temp.outputCount(), inputCount(), outputCount());
+			return;
+		}
+		m_ConeTable = new ConeTable { std::move(temp) };
+		m_Version   = NextVersion();
+	}
+
+	// For components too wide for a truth table, usually provided by Graph::compileDiagram
+	template <Callable<DecisionDiagram> F>
+	void setDecisionDiagram(F&& decisionDiagramProvider)
+	{
+		if (m_DecisionDiagram)
+		{
+			Log::Warn("Trying to override decision diagram for component {}:{};{}", m_Name.m_Namespace, m_Name.m_Name, inputCount());
+			return;
+		}
+
+		DecisionDiagram temp = decisionDiagramProvider();
+		if (!temp.valid())
+		{
+			Log::Warn("Trying to set an incomplete decision diagram for component {}:{};{}", m_Name.m_Namespace, m_Name.m_Name, inputCount());
+			return;
+		}
+		if (temp.inputCount() != inputCount() || temp.outputCount() != outputCount())
+		{
+			Log::Warn("Trying to set decision diagram with incorrect input and output count, received {}/{}, requires {}/{}", temp.inputCount(), temp.outputCount(), inputCount(), outputCount());
+			return;
+		}
+		m_DecisionDiagram = new DecisionDiagram { std::move(temp) };
+		m_Version         = NextVersion();
 	}
 
 	template <Callable<Graph> F>
@@ -112,32 +215,83 @@ public:
 		}
 
 		Graph temp = graphProvider();
-		if (temp.inputCount() != inputCount() && temp.outputCount() != outputCount())
+		if (temp.inputCount() != inputCount() || temp.outputCount() != outputCount())
 		{
 			Log::Warn("Trying to set graph with incorrect input and output count, received {}/{}, requires {}/{}", temp.inputCount(), temp.outputCount(), inputCount(), outputCount());
 			return;
 		}
-		m_Graph = new Graph { std::move(temp) };
+		m_Graph   = new Graph { std::move(temp) };
+		m_Version = NextVersion();
+	}
+
+	// Replaces the graph, representations compiled from the previous graph are dropped until the next compileGraph().
+	// GraphStates and Netlists built over the previous graph report outdated() and refuse to tick until they are rebuilt
+	template <Callable<Graph> F>
+	void replaceGraph(F&& graphProvider)
+	{
+		if (!m_Graph)
+		{
+			setGraph(std::forward<F>(graphProvider));
+			return;
+		}
+
+		Graph temp = graphProvider();
+		if (temp.inputCount() != inputCount() || temp.outputCount() != outputCount())
+		{
+			Log::Warn("Trying to replace graph with incorrect input and output count, received {}/{}, requires {}/{}", temp.inputCount(), temp.outputCount(), inputCount(), outputCount());
+			return;
+		}
+		*m_Graph  = std::move(temp);
+		m_Version = NextVersion();
+		dropCompiled();
 	}
 
+	// Compiles the graph into a truth table, or a cone table or decision diagram when it is too wide, graphs with feedback stay interpreted.
+	// The component is kept compiled, after dropCompiled() the next DependencyTracker::refresh() compiles it again.
+	// Truth tables are looked up in and added to `cache` when one is given, and enumerated across `pool` when one is given
+	void compileGraph(TruthTableCache* cache = nullptr, ThreadPool* pool = nullptr);
+	// Drops representations produced by compileGraph(), ones that were set explicitly are kept
+	void dropCompiled();
+	// Compiled once, but the representations were dropped or the graph was edited since
+	bool needsCompile() const { return m_CompileRequested && (!m_Compiled || m_CompiledRevision != m_Graph->revision()); }
+	// Changes whenever a representation is set, replaced or dropped, versions are unique across all components
+	std::uint64_t version() const { return m_Version; }
+
 	std::size_t inputCount() const { return m_InputNames.size(); }
 	std::size_t outputCount() const { return m_OutputNames.size(); }
 
-	auto&             getName() const { return m_Name; }
-	auto&             getInputNames() const { return m_InputNames; }
-	auto&             getOutputNames() const { return m_OutputNames; }
-	bool              hasTruthTable() const { return m_TruthTable; }
-	bool              hasGraph() const { return m_Graph; }
-	TruthTable&       getTruthTable() { return *m_TruthTable; }
-	const TruthTable& getTruthTable() const { return *m_TruthTable; }
-	Graph&            getGraph() { return *m_Graph; }
-	const Graph&      getGraph() const { return *m_Graph; }
+	auto&                  getName() const { return m_Name; }
+	auto&                  getInputNames() const { return m_InputNames; }
+	auto&                  getOutputNames() const { return m_OutputNames; }
+	GateOp                 getGate() const { return m_Gate; }
+	bool                   hasGate() const { return m_Gate != GateOp::Table; }
+	bool                   hasTruthTable() const { return m_TruthTable; }
+	bool                   hasConeTable() const { return m_ConeTable; }
+	bool                   hasDecisionDiagram() const { return m_DecisionDiagram; }
+	bool                   hasGraph() const { return m_Graph; }
+	TruthTable&            getTruthTable() { return *m_TruthTable; }
+	const TruthTable&      getTruthTable() const { return *m_TruthTable; }
+	const ConeTable&       getConeTable() const { return *m_ConeTable; }
+	const DecisionDiagram& getDecisionDiagram() const { return *m_DecisionDiagram; }
+	Graph&                 getGraph() { return *m_Graph; }
+	const Graph&           getGraph() const { return *m_Graph; }
+
+private:
+	static std::uint64_t NextVersion();
 
 private:
 	NamespaceName            m_Name;
 	std::vector<std::string> m_InputNames;
 	std::vector<std::string> m_OutputNames;
 
-	TruthTable* m_TruthTable;
-	Graph*      m_Graph;
+	GateOp           m_Gate;
+	TruthTable*      m_TruthTable;
+	ConeTable*       m_ConeTable;
+	DecisionDiagram* m_DecisionDiagram;
+	Graph*           m_Graph;
+
+	bool          m_CompileRequested;
+	bool          m_Compiled;
+	std::uint64_t m_CompiledRevision; // Graph revision the compiled representations were built from
+	std::uint64_t m_Version;
 };
\ No newline at end of file
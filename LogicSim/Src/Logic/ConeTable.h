@@ -0,0 +1,83 @@
+#pragma once
+
+#include "TruthTable.h"
+
+#include <cstdint>
+
+#include <vector>
+
+// Component compiled per output cone of influence.
+// Outputs that depend on the same set of inputs share one TruthTable over just those inputs, with a gather map from component ports to table ports.
+// A locally connected component thus needs tables of 2^support rows instead of one of 2^inputCount rows, and can be wider than a single table allows.
+struct ConeTable
+{
+public:
+	struct Cone
+	{
+	public:
+		std::vector<std::uint32_t> m_Inputs;  // Component input read by each table input
+		std::vector<std::uint32_t> m_Outputs; // Component output written by each table output
+		TruthTable                 m_TruthTable;
+	};
+
+public:
+	ConeTable(std::size_t numInputs, std::size_t numOutputs)
+	    : m_NumInputs(numInputs),
+	      m_NumOutputs(numOutputs),
+	      m_Valid(true) {}
+
+	void addCone(Cone cone) { m_Cones.emplace_back(std::move(cone)); }
+	void invalidate()
+	{
+		m_Cones.clear();
+		m_Valid = false;
+	}
+
+	// `input` is called with a component input index and returns its value, `output` receives a component output index and its value
+	template <Callable<bool, std::size_t> F, Callable<void, std::size_t, bool> G>
+	void evaluate(F&& input, G&& output) const
+	{
+		for (auto& cone : m_Cones)
+		{
+			std::uint16_t inputs = 0;
+			for (std::size_t i = 0; i < cone.m_Inputs.size(); ++i)
+				inputs |= static_cast<std::uint16_t>(input(cone.m_Inputs[i])) << i;
+
+			auto& truthTable = cone.m_TruthTable;
+			if (truthTable.isAligned())
+			{
+				std::uint64_t row = truthTable.getRow(inputs);
+				for (std::size_t i = 0; i < cone.m_Outputs.size(); ++i)
+					output(cone.m_Outputs[i], (row >> i) & 1);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < cone.m_Outputs.size(); ++i)
+					output(cone.m_Outputs[i], truthTable.getOutput(inputs, i));
+			}
+		}
+	}
+
+	// False when some cone was too wide for a TruthTable, no cones are kept then
+	bool valid() const { return m_Valid; }
+
+	std::size_t inputCount() const { return m_NumInputs; }
+	std::size_t outputCount() const { return m_NumOutputs; }
+	std::size_t coneCount() const { return m_Cones.size(); }
+
+	auto& getCones() const { return m_Cones; }
+
+	std::size_t allocatedSize() const
+	{
+		std::size_t size = sizeof(*this) + (m_Cones.capacity() - m_Cones.size()) * sizeof(Cone);
+		for (auto& cone : m_Cones)
+			size += cone.m_TruthTable.allocatedSize() + (cone.m_Inputs.capacity() + cone.m_Outputs.capacity()) * sizeof(std::uint32_t);
+		return size;
+	}
+
+private:
+	std::size_t       m_NumInputs;
+	std::size_t       m_NumOutputs;
+	std::vector<Cone> m_Cones;
+	bool              m_Valid;
+};
\ No newline at end of file
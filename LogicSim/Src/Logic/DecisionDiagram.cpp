@@ -0,0 +1,284 @@
+#include "DecisionDiagram.h"
+#include "Netlist.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+struct DecisionDiagram::Builder
+{
+public:
+	struct Key
+	{
+	public:
+		std::uint32_t m_A;
+		std::uint32_t m_B;
+		std::uint32_t m_C;
+
+		friend bool operator==(const Key& lhs, const Key& rhs) = default;
+	};
+
+	struct KeyHash
+	{
+	public:
+		std::size_t operator()(const Key& key) const
+		{
+			std::uint64_t hash = ((std::uint64_t { key.m_A } << 32) | key.m_B) * 0x9E37'79B9'7F4A'7C15ULL;
+			hash              ^= key.m_C * 0xC2B2'AE3D'27D4'EB4FULL;
+			return hash ^ (hash >> 29);
+		}
+	};
+
+public:
+	Builder(DecisionDiagram& diagram, std::size_t maxNodes)
+	    : m_Diagram(diagram),
+	      m_MaxNodes(maxNodes),
+	      m_Overflow(false) {}
+
+	std::uint32_t level(std::uint32_t node) const { return m_Diagram.m_Nodes[node].m_Level; }
+
+	std::uint32_t makeNode(std::uint32_t level, std::uint32_t low, std::uint32_t high)
+	{
+		if (low == high)
+			return low;
+
+		auto [itr, inserted] = m_Unique.try_emplace(Key { level, low, high }, static_cast<std::uint32_t>(m_Diagram.m_Nodes.size()));
+		if (inserted)
+		{
+			if (m_Diagram.m_Nodes.size() >= m_MaxNodes)
+			{
+				m_Overflow = true;
+				m_Unique.erase(itr);
+				return c_False;
+			}
+			m_Diagram.m_Nodes.push_back({ level, low, high });
+		}
+		return itr->second;
+	}
+
+	std::uint32_t cofactor(std::uint32_t node, std::uint32_t top, bool value) const
+	{
+		if (level(node) != top)
+			return node;
+		auto& decision = m_Diagram.m_Nodes[node];
+		return value ? decision.m_High : decision.m_Low;
+	}
+
+	// if f then g else h, every other operation is expressed through it
+	std::uint32_t ite(std::uint32_t f, std::uint32_t g, std::uint32_t h)
+	{
+		if (m_Overflow)
+			return c_False;
+		if (f == c_True || g == h)
+			return g;
+		if (f == c_False)
+			return h;
+		if (g == c_True && h == c_False)
+			return f;
+
+		Key key { f, g, h };
+		if (auto itr = m_Computed.find(key); itr != m_Computed.end())
+			return itr->second;
+
+		std::uint32_t top    = std::min({ level(f), level(g), level(h) });
+		std::uint32_t high   = ite(cofactor(f, top, true), cofactor(g, top, true), cofactor(h, top, true));
+		std::uint32_t low    = ite(cofactor(f, top, false), cofactor(g, top, false), cofactor(h, top, false));
+		std::uint32_t result = makeNode(top, low, high);
+		if (m_Computed.size() >= m_MaxNodes)
+			m_Computed.clear();
+		m_Computed.emplace(key, result);
+		return result;
+	}
+
+	std::uint32_t negate(std::uint32_t f) { return ite(f, c_False, c_True); }
+
+	void evaluate(const Netlist& netlist, const NetlistInstruction& instruction, std::vector<std::uint32_t>& values)
+	{
+		auto inputs  = netlist.getInputs(instruction);
+		auto outputs = netlist.getOutputs(instruction);
+		if (instruction.m_Op == GateOp::Table)
+		{
+			// Same mux tree as PatternState, every level selects between row pairs using the next input
+			auto&       truthTable = *instruction.m_TruthTable;
+			std::size_t rows       = 1ULL << inputs.size();
+			m_Results.resize(outputs.size());
+			for (std::size_t output = 0; output < outputs.size(); ++output)
+			{
+				m_Results[output] = c_False;
+				if (outputs[output] == Netlist::c_SinkConnection)
+					continue;
+
+				m_Rows.resize(rows);
+				for (std::size_t row = 0; row < rows; ++row)
+					m_Rows[row] = truthTable.getOutput(static_cast<std::uint16_t>(row), output) ? c_True : c_False;
+				for (std::size_t i = 0, count = rows; i < inputs.size(); ++i, count >>= 1)
+				{
+					std::uint32_t select = values[inputs[i]];
+					for (std::size_t row = 0; row < count; row += 2)
+						m_Rows[row >> 1] = ite(select, m_Rows[row + 1], m_Rows[row]);
+				}
+				m_Results[output] = m_Rows[0];
+			}
+			for (std::size_t output = 0; output < outputs.size(); ++output)
+				values[outputs[output]] = m_Results[output];
+			return;
+		}
+
+		if (outputs[0] == Netlist::c_SinkConnection)
+			return;
+
+		std::uint32_t result = c_False;
+		switch (instruction.m_Op)
+		{
+		case GateOp::Buffer:
+			result = values[inputs[0]];
+			break;
+		case GateOp::And:
+		case GateOp::Nand:
+			result = c_True;
+			for (std::size_t input : inputs)
+				result = ite(result, values[input], c_False);
+			break;
+		case GateOp::Or:
+		case GateOp::Nor:
+			for (std::size_t input : inputs)
+				result = ite(result, c_True, values[input]);
+			break;
+		case GateOp::Xor:
+		case GateOp::Xnor:
+		{
+			// Tracks whether no input or exactly one input was high so far
+			std::uint32_t none = c_True;
+			for (std::size_t input : inputs)
+			{
+				std::uint32_t value = values[input];
+				result              = ite(value, none, result);
+				none                = ite(value, c_False, none);
+			}
+			break;
+		}
+		default: break;
+		}
+		if (instruction.m_Op == GateOp::Nand || instruction.m_Op == GateOp::Nor || instruction.m_Op == GateOp::Xnor)
+			result = negate(result);
+		values[outputs[0]] = result;
+	}
+
+public:
+	DecisionDiagram& m_Diagram;
+	std::size_t      m_MaxNodes;
+	bool             m_Overflow;
+
+	std::unordered_map<Key, std::uint32_t, KeyHash> m_Unique;
+	std::unordered_map<Key, std::uint32_t, KeyHash> m_Computed;
+	std::vector<std::uint32_t>                      m_Rows;
+	std::vector<std::uint32_t>                      m_Results;
+};
+
+DecisionDiagram::DecisionDiagram(std::size_t numInputs, std::size_t numOutputs)
+    : m_Nodes({ { ~0U, c_False, c_False }, { ~0U, c_True, c_True } }),
+      m_Roots(numOutputs, c_False),
+      m_Order(numInputs),
+      m_Valid(true)
+{
+	for (std::size_t i = 0; i < numInputs; ++i)
+		m_Order[i] = static_cast<std::uint32_t>(i);
+}
+
+DecisionDiagram::DecisionDiagram(const Netlist& netlist, std::size_t maxNodes)
+    : DecisionDiagram(0, netlist.outputCount())
+{
+	auto& instructions = netlist.getInstructions();
+	auto& inputs       = netlist.getInputs();
+	auto& outputs      = netlist.getOutputs();
+
+	std::vector<std::size_t> writers(netlist.connectionCount(), ~0ULL);
+	std::vector<std::size_t> inputOf(netlist.connectionCount(), ~0ULL);
+	for (std::size_t i = 0; i < instructions.size(); ++i)
+		for (std::size_t connection : netlist.getOutputs(instructions[i]))
+			writers[connection] = i;
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		if (inputs[i] != Netlist::c_SinkConnection)
+			inputOf[inputs[i]] = i;
+
+	// Inputs get their level in the order a depth first walk from the outputs reaches them
+	std::vector<std::uint32_t> levels(inputs.size(), ~0U);
+	std::vector<std::size_t>   stack;
+	BitSet                     visited(instructions.size());
+	for (std::size_t output : outputs)
+	{
+		stack.push_back(output);
+		while (!stack.empty())
+		{
+			std::size_t connection = stack.back();
+			stack.pop_back();
+
+			std::size_t input = inputOf[connection];
+			if (input != ~0ULL && levels[input] == ~0U)
+			{
+				levels[input] = static_cast<std::uint32_t>(m_Order.size());
+				m_Order.push_back(static_cast<std::uint32_t>(input));
+			}
+
+			std::size_t writer = writers[connection];
+			if (writer == ~0ULL || visited.get(writer))
+				continue;
+			visited.set(writer, true);
+			auto operands = netlist.getInputs(instructions[writer]);
+			stack.insert(stack.end(), operands.rbegin(), operands.rend());
+		}
+	}
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+	{
+		if (levels[i] != ~0U)
+			continue;
+		levels[i] = static_cast<std::uint32_t>(m_Order.size());
+		m_Order.push_back(static_cast<std::uint32_t>(i));
+	}
+
+	Builder                    builder { *this, std::max<std::size_t>(maxNodes, 2) };
+	std::vector<std::uint32_t> values(netlist.connectionCount(), c_False);
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		if (inputs[i] != Netlist::c_SinkConnection)
+			values[inputs[i]] = builder.makeNode(levels[i], c_False, c_True);
+	for (auto& instruction : instructions)
+		builder.evaluate(netlist, instruction, values);
+
+	if (builder.m_Overflow)
+	{
+		m_Valid = false;
+		m_Nodes.resize(2);
+		m_Nodes.shrink_to_fit();
+		return;
+	}
+
+	for (std::size_t i = 0; i < outputs.size(); ++i)
+		m_Roots[i] = values[outputs[i]];
+
+	// Drop intermediate results, only nodes reachable from the outputs are kept in their bottom up order
+	BitSet reachable(m_Nodes.size());
+	for (std::uint32_t root : m_Roots)
+		reachable.set(root, true);
+	for (std::size_t i = m_Nodes.size(); i-- > 2;)
+	{
+		if (!reachable.get(i))
+			continue;
+		reachable.set(m_Nodes[i].m_Low, true);
+		reachable.set(m_Nodes[i].m_High, true);
+	}
+
+	std::vector<std::uint32_t> remap(m_Nodes.size(), c_False);
+	std::uint32_t              count = 2;
+	remap[c_True]                    = c_True;
+	for (std::size_t i = 2; i < m_Nodes.size(); ++i)
+	{
+		if (!reachable.get(i))
+			continue;
+		remap[i]       = count;
+		m_Nodes[count] = { m_Nodes[i].m_Level, remap[m_Nodes[i].m_Low], remap[m_Nodes[i].m_High] };
+		++count;
+	}
+	m_Nodes.resize(count);
+	m_Nodes.shrink_to_fit();
+	for (auto& root : m_Roots)
+		root = remap[root];
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Utils/BitSet.h"
+#include "Utils/Utils.h"
+
+#include <cstdint>
+
+#include <vector>
+
+struct Netlist;
+
+// Reduced ordered binary decision diagram with one root per output, all outputs share their nodes.
+// Used for components too wide for a TruthTable, evaluation follows a single path of at most inputCount() nodes per output.
+// Variables are ordered by a depth first walk from the outputs, so inputs feeding the same gates end up next to each other.
+struct DecisionDiagram
+{
+public:
+	static constexpr std::uint32_t c_False           = 0;
+	static constexpr std::uint32_t c_True            = 1;
+	static constexpr std::size_t   c_DefaultMaxNodes = 1 << 22;
+
+	// Nodes are stored bottom up, children always have a lower index than their parent
+	struct Decision
+	{
+	public:
+		std::uint32_t m_Level; // Position of the tested input in m_Order, ~0U for the two terminals
+		std::uint32_t m_Low;
+		std::uint32_t m_High;
+	};
+
+public:
+	// Every output constant low
+	DecisionDiagram(std::size_t numInputs, std::size_t numOutputs);
+	// Symbolically evaluates one tick of `netlist` from a reset state, gives up once more than `maxNodes` nodes are needed
+	DecisionDiagram(const Netlist& netlist, std::size_t maxNodes = c_DefaultMaxNodes);
+
+	// `input` is called with an input index and returns its value, only inputs on the evaluated path are read
+	template <Callable<bool, std::size_t> F>
+	bool getOutput(std::size_t output, F&& input) const
+	{
+		std::uint32_t node = m_Roots[output];
+		while (node > c_True)
+		{
+			auto& decision = m_Nodes[node];
+			node           = input(m_Order[decision.m_Level]) ? decision.m_High : decision.m_Low;
+		}
+		return node == c_True;
+	}
+
+	void getOutputs(ConstBitSpan inputs, BitSpan outputs) const
+	{
+		for (std::size_t i = 0; i < m_Roots.size(); ++i)
+			outputs.set(i, getOutput(i, [&inputs](std::size_t input) { return inputs.get(input); }));
+	}
+
+	// False when the node limit was hit while building, every output is low then
+	bool valid() const { return m_Valid; }
+
+	std::size_t inputCount() const { return m_Order.size(); }
+	std::size_t outputCount() const { return m_Roots.size(); }
+	std::size_t nodeCount() const { return m_Nodes.size(); }
+
+	auto& getNodes() const { return m_Nodes; }
+	auto& getRoots() const { return m_Roots; }
+	auto& getOrder() const { return m_Order; }
+
+	std::size_t allocatedSize() const
+	{
+		return sizeof(*this) + m_Nodes.capacity() * sizeof(Decision) + (m_Roots.capacity() + m_Order.capacity()) * sizeof(std::uint32_t);
+	}
+
+private:
+	struct Builder;
+
+private:
+	std::vector<Decision>      m_Nodes;
+	std::vector<std::uint32_t> m_Roots;
+	std::vector<std::uint32_t> m_Order;
+
+	bool m_Valid;
+};
\ No newline at end of file
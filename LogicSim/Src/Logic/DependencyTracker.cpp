@@ -0,0 +1,131 @@
+#include "DependencyTracker.h"
+#include "RevisionSet.h"
+
+#include <algorithm>
+
+void DependencyTracker::invalidate(std::size_t component)
+{
+	std::vector<std::size_t>        pending { component };
+	std::unordered_set<std::size_t> visited { component };
+	while (!pending.empty())
+	{
+		std::size_t index = pending.back();
+		pending.pop_back();
+
+		if (auto resource = m_Components.getResource(index))
+			resource->dropCompiled();
+
+		auto itr = m_Parents.find(index);
+		if (itr == m_Parents.end())
+			continue;
+		for (std::size_t parent : itr->second)
+			if (visited.insert(parent).second)
+				pending.push_back(parent);
+	}
+}
+
+void DependencyTracker::refresh(std::size_t component)
+{
+	if (!update())
+		return;
+
+	std::unordered_set<std::size_t> visited;
+	compileBelow(component, visited);
+}
+
+void DependencyTracker::refreshAll()
+{
+	if (!update())
+		return;
+
+	std::unordered_set<std::size_t> visited;
+	for (auto& resource : m_Components)
+		compileBelow(resource.index(), visited);
+}
+
+void DependencyTracker::remove(std::size_t component)
+{
+	invalidate(component);
+
+	auto itr = m_Children.find(component);
+	if (itr != m_Children.end())
+	{
+		for (std::size_t child : itr->second)
+			std::erase(m_Parents[child], component);
+		m_Children.erase(itr);
+	}
+	m_Revisions.erase(component);
+}
+
+bool DependencyTracker::update()
+{
+	// Read before scanning, an edit racing the scan moves the revision past what gets recorded
+	std::uint64_t current = RevisionSet::CurrentRevision();
+	if (current == m_CurrentRevision)
+		return false;
+
+	bool                     stale = false;
+	std::vector<std::size_t> edited;
+	for (auto& resource : m_Components)
+	{
+		auto& component = *resource;
+		if (!component.hasGraph())
+			continue;
+
+		std::size_t index    = resource.index();
+		auto&       graph    = component.getGraph();
+		auto        revision = m_Revisions.find(index);
+		stale                = stale || component.needsCompile();
+		if (revision != m_Revisions.end() && revision->second == graph.revision())
+			continue;
+
+		// Components compiled before they were first scanned can still have been edited, the compiled revision tells
+		if (revision != m_Revisions.end() || component.needsCompile())
+			edited.push_back(index);
+		m_Revisions[index] = graph.revision();
+		scan(index, graph);
+	}
+
+	// Done after scanning, so the parents of every edited graph are known
+	for (std::size_t index : edited)
+		invalidate(index);
+	// Stale components may lie outside what the caller refreshes, so only a clean scan is skipped next time
+	if (!stale && edited.empty())
+		m_CurrentRevision = current;
+	return stale || !edited.empty();
+}
+
+void DependencyTracker::scan(std::size_t component, const Graph& graph)
+{
+	auto& children = m_Children[component];
+	for (std::size_t child : children)
+		std::erase(m_Parents[child], component);
+
+	children.clear();
+	for (auto& node : graph.getNodes())
+	{
+		auto& child = node->getComponent();
+		if (child.pool() != &m_Components || std::find(children.begin(), children.end(), child.index()) != children.end())
+			continue;
+		children.push_back(child.index());
+	}
+	for (std::size_t child : children)
+		m_Parents[child].push_back(component);
+}
+
+void DependencyTracker::compileBelow(std::size_t component, std::unordered_set<std::size_t>& visited)
+{
+	if (!visited.insert(component).second)
+		return;
+	auto resource = m_Components.getResource(component);
+	if (!resource)
+		return;
+
+	// Parents flatten the representations of their children, so those have to be current first
+	auto itr = m_Children.find(component);
+	if (itr != m_Children.end())
+		for (std::size_t child : itr->second)
+			compileBelow(child, visited);
+	if (resource->needsCompile())
+		resource->compileGraph(m_Cache, m_Pool);
+}
\ No newline at end of file
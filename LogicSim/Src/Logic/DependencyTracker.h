@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Component.h"
+#include "ResourceManager/ResourceManager.h"
+
+#include <cstdint>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Tracks which components use which other components in their graphs, so editing a component only recompiles the components above it.
+// Edits are picked up from graph revisions, invalidated components are recompiled lazily by refresh(), children before their parents.
+struct DependencyTracker
+{
+public:
+	using ComponentPool = ResourceManager::ResourcePool<Component>;
+
+public:
+	DependencyTracker(ComponentPool& components)
+	    : m_Components(components),
+	      m_CurrentRevision(~0ULL),
+	      m_Cache(nullptr),
+	      m_Pool(nullptr) {}
+
+	// Recompiled truth tables go through `cache`, nullptr compiles every table from scratch
+	void setCache(TruthTableCache* cache) { m_Cache = cache; }
+	// Truth tables are enumerated across `pool`, nullptr compiles them on the calling thread
+	void setThreadPool(ThreadPool* pool) { m_Pool = pool; }
+
+	// Drops the compiled representations of `component` and of every component using it, directly or through other graphs
+	void invalidate(std::size_t component);
+	// Recompiles `component` and the components below it where needed
+	void refresh(std::size_t component);
+	void refreshAll();
+	// Forgets a component that is about to be removed, components using it are invalidated
+	void remove(std::size_t component);
+
+	// Components whose graphs contain `component`, as of the last refresh
+	const std::vector<std::size_t>& getParents(std::size_t component) const
+	{
+		static const std::vector<std::size_t> c_None;
+
+		auto itr = m_Parents.find(component);
+		return itr != m_Parents.end() ? itr->second : c_None;
+	}
+
+private:
+	// Rescans graphs edited since the last update and invalidates everything above them, returns whether any component needs compiling.
+	// Returns right away while nothing was edited since an update that found every component current
+	bool update();
+	void scan(std::size_t component, const Graph& graph);
+	void compileBelow(std::size_t component, std::unordered_set<std::size_t>& visited);
+
+private:
+	ComponentPool& m_Components;
+
+	std::unordered_map<std::size_t, std::vector<std::size_t>> m_Parents;
+	std::unordered_map<std::size_t, std::vector<std::size_t>> m_Children;
+	std::unordered_map<std::size_t, std::uint64_t>            m_Revisions;       // Graph revision of every scanned component
+	std::uint64_t                                             m_CurrentRevision; // Edit revision everything was found current at, see RevisionSet
+
+	TruthTableCache* m_Cache;
+	ThreadPool*      m_Pool;
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "Gate.h"
+
+TruthTable GateTruthTable(GateOp op, std::uint8_t inputCount)
+{
+	return TruthTable {
+		inputCount, 1,
+		[op, inputCount](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
+		{
+			bitSet.set(bit, EvaluateGate(op, inputs, inputCount));
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "TruthTable.h"
+
+#include <cstdint>
+
+#include <bit>
+
+enum class GateOp : std::uint8_t
+{
+	Table,  // Generic truth table
+	Buffer, // Copies its single input to its single output
+	And,
+	Or,
+	Nand,
+	Nor,
+	Xor, // High when exactly one input is high
+	Xnor
+};
+
+// Evaluates a single output primitive gate over the low `inputCount` bits of `inputs`
+constexpr bool EvaluateGate(GateOp op, std::uint64_t inputs, std::size_t inputCount)
+{
+	std::uint64_t mask = inputCount >= 64 ? ~0ULL : (1ULL << inputCount) - 1;
+	inputs            &= mask;
+	switch (op)
+	{
+	case GateOp::Buffer: return inputs & 1;
+	case GateOp::And: return inputs == mask;
+	case GateOp::Or: return inputs != 0;
+	case GateOp::Nand: return inputs != mask;
+	case GateOp::Nor: return inputs == 0;
+	case GateOp::Xor: return std::has_single_bit(inputs);
+	case GateOp::Xnor: return !std::has_single_bit(inputs);
+	default: return false;
+	}
+}
+
+// Truth table equivalent of a primitive gate, for code that only understands tables
+TruthTable GateTruthTable(GateOp op, std::uint8_t inputCount);
\ No newline at end of file
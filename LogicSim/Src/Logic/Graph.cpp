@@ -1,20 +1,75 @@
 #include "Graph.h"
 #include "Component.h"
 #include "GraphState.h"
+#include "Netlist.h"
+#include "PatternState.h"
+#include "RevisionSet.h"
 
-Node::Node(ResourceManager::Ref<Component> component)
+#include <algorithm>
+
+Node::Node(ResourceManager::Ref<Component> component, std::size_t portOffset)
     : m_Component(component),
-      m_InputPorts(component->inputCount(), ~0ULL),
-      m_OutputPorts(component->outputCount(), ~0ULL) {}
+      m_PortOffset(portOffset),
+      m_InputCount(static_cast<std::uint32_t>(component->inputCount())),
+      m_OutputCount(static_cast<std::uint32_t>(component->outputCount())) {}
 
 Graph::NodeRef Graph::newNode(ResourceManager::Ref<Component> component)
 {
-	return m_Nodes.emplaceBack(component);
+	m_Revision = NextRevision();
+
+	auto node = m_Nodes.emplaceBack(component, m_NodePorts.size());
+	m_NodePorts.resize(m_NodePorts.size() + node->portCount(), ~0ULL);
+	return node;
+}
+
+std::vector<Graph::NodeRef> Graph::newNodes(ResourceManager::Ref<Component> component, std::size_t count)
+{
+	m_Revision = NextRevision();
+
+	std::size_t          portOffset = m_NodePorts.size();
+	std::size_t          portCount  = component->inputCount() + component->outputCount();
+	auto                 first      = m_Nodes.emplaceRange(count, component, portOffset);
+	std::vector<NodeRef> nodes;
+	nodes.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto node          = m_Nodes.getRef(first.index() + i);
+		node->m_PortOffset = portOffset + i * portCount;
+		nodes.push_back(node);
+	}
+	m_NodePorts.resize(portOffset + count * portCount, ~0ULL);
+	return nodes;
 }
 
 void Graph::removeNode(NodeRef node)
 {
+	if (node.pool() != &m_Nodes || !node.alive())
+		return;
+
+	m_Revision = NextRevision();
+	m_UnusedNodePorts += node->portCount();
 	m_Nodes.erase(node.index());
+	if (m_UnusedNodePorts * 2 > m_NodePorts.size())
+		compactNodePorts();
+}
+
+void Graph::removeNodes(const std::vector<NodeRef>& nodes)
+{
+	std::vector<std::size_t> indices;
+	indices.reserve(nodes.size());
+	for (auto& node : nodes)
+		if (node.pool() == &m_Nodes && node.alive())
+			indices.push_back(node.index());
+	if (indices.empty())
+		return;
+
+	m_Revision = NextRevision();
+	for (std::size_t index : indices)
+		if (auto node = m_Nodes.getResource(index))
+			m_UnusedNodePorts += node->portCount();
+	m_Nodes.eraseMany(indices);
+	if (m_UnusedNodePorts * 2 > m_NodePorts.size())
+		compactNodePorts();
 }
 
 void Graph::connect(Port a, Port b)
@@ -22,6 +77,8 @@ void Graph::connect(Port a, Port b)
 	if (a.m_Node == b.m_Node && a.m_Port == b.m_Port)
 		return;
 
+	m_Revision = NextRevision();
+
 	std::size_t aConnection = getPortConnection(a);
 	std::size_t bConnection = getPortConnection(b);
 
@@ -43,28 +100,19 @@ void Graph::connect(Port a, Port b)
 		for (std::size_t i = 0; i < m_InputPorts.size(); ++i)
 			if (m_InputPorts[i] == largeConnection)
 				m_InputPorts[i] = connection;
-			else if (m_InputPorts[i] > largeConnection)
+			else if (m_InputPorts[i] > largeConnection && m_InputPorts[i] != ~0ULL)
 				--m_InputPorts[i];
 		for (std::size_t i = 0; i < m_OutputPorts.size(); ++i)
 			if (m_OutputPorts[i] == largeConnection)
 				m_OutputPorts[i] = connection;
-			else if (m_OutputPorts[i] > largeConnection)
+			else if (m_OutputPorts[i] > largeConnection && m_OutputPorts[i] != ~0ULL)
 				--m_OutputPorts[i];
-		for (auto& node : m_Nodes)
-		{
-			auto& inputPorts  = node->getInputPorts();
-			auto& outputPorts = node->getOutputPorts();
-			for (std::size_t i = 0; i < inputPorts.size(); ++i)
-				if (inputPorts[i] == largeConnection)
-					inputPorts[i] = connection;
-				else if (inputPorts[i] > largeConnection)
-					--inputPorts[i];
-			for (std::size_t i = 0; i < outputPorts.size(); ++i)
-				if (outputPorts[i] == largeConnection)
-					outputPorts[i] = connection;
-				else if (outputPorts[i] > largeConnection)
-					--outputPorts[i];
-		}
+		// Unused blocks are rewritten as well, nothing reads them
+		for (std::size_t i = 0; i < m_NodePorts.size(); ++i)
+			if (m_NodePorts[i] == largeConnection)
+				m_NodePorts[i] = connection;
+			else if (m_NodePorts[i] > largeConnection && m_NodePorts[i] != ~0ULL)
+				--m_NodePorts[i];
 	}
 
 	setPortConnection(a, aConnection);
@@ -85,35 +133,151 @@ void Graph::disconnect(Port a, Port b)
 	// TODO(MarcasRealAccount): Implement
 }
 
-TruthTable Graph::compile() const
+// Evaluates the block of input combinations starting at `base` and stores its rows, a block covers laneCount() consecutive rows
+static void EnumerateBlock(PatternState& state, const std::vector<std::uint32_t>& inputs, const std::vector<std::uint32_t>& outputs, std::size_t base, BitSet& rows, std::size_t rowBits)
+{
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		for (std::size_t j = 0; j < state.wordCount(); ++j)
+			state.setInput(inputs[i], j, PatternState::EnumerationPattern(i, base + j * PatternState::c_WordLanes));
+	state.tick();
+
+	std::size_t count = std::min<std::size_t>(state.laneCount(), (1ULL << inputs.size()) - base);
+	for (std::size_t lane = 0; lane < count; ++lane)
+		for (std::size_t i = 0; i < outputs.size(); ++i)
+			rows.set((base + lane) * rowBits + i, (state.getOutput(outputs[i], lane / PatternState::c_WordLanes) >> (lane % PatternState::c_WordLanes)) & 1);
+}
+
+// Enumerates every combination of the netlist inputs in `inputs`, the remaining inputs stay low.
+// With a pool every worker evaluates whole blocks on its own PatternState, a block spans a multiple of 64 rows so workers never write the same word.
+// Feedback carries state from one block to the next, so netlists with feedback are always enumerated in order on the calling thread.
+static TruthTable CompileTable(const Netlist& netlist, const std::vector<std::uint32_t>& inputs, const std::vector<std::uint32_t>& outputs, ThreadPool* pool)
+{
+	std::size_t rowBits   = TruthTable::RowBits(outputs.size(), TruthTableLayout::Aligned);
+	std::size_t rowCount  = 1ULL << inputs.size();
+	std::size_t laneCount = PatternState::PreferredWordCount() * PatternState::c_WordLanes;
+	std::size_t blocks    = (rowCount + laneCount - 1) / laneCount;
+	BitSet      rows(rowCount * rowBits);
+
+	auto& schedule = netlist.getSchedule();
+	if (!pool || blocks < 2 || schedule.feedbackBegin() != schedule.feedbackEnd())
+	{
+		PatternState state { netlist };
+		for (std::size_t block = 0; block < blocks; ++block)
+			EnumerateBlock(state, inputs, outputs, block * laneCount, rows, rowBits);
+	}
+	else
+	{
+		std::vector<PatternState> states;
+		states.reserve(pool->workerCount());
+		for (std::size_t i = 0; i < pool->workerCount(); ++i)
+			states.emplace_back(netlist);
+
+		auto enumerateRange = [&](std::size_t begin, std::size_t end, std::size_t worker)
+		{
+			for (std::size_t block = begin; block < end; ++block)
+				EnumerateBlock(states[worker], inputs, outputs, block * laneCount, rows, rowBits);
+		};
+		pool->parallelForDynamic(blocks, 1, enumerateRange);
+	}
+	return TruthTable { static_cast<std::uint8_t>(inputs.size()), outputs.size(), std::move(rows) };
+}
+
+static ConeTable CompileCones(const Graph& graph, ThreadPool* pool)
+{
+	Netlist   netlist { graph };
+	ConeTable cones { graph.inputCount(), graph.outputCount() };
+
+	// Outputs with exactly the same support are grouped into one cone
+	std::vector<BitSet>                     support = netlist.computeSupport();
+	std::vector<std::vector<std::uint32_t>> groups;
+	std::vector<std::size_t>                groupSupport;
+	for (std::size_t i = 0; i < support.size(); ++i)
+	{
+		auto itr = std::find_if(groupSupport.begin(), groupSupport.end(), [&](std::size_t output) { return support[output] == support[i]; });
+		if (itr != groupSupport.end())
+		{
+			groups[itr - groupSupport.begin()].push_back(static_cast<std::uint32_t>(i));
+			continue;
+		}
+		groups.push_back({ static_cast<std::uint32_t>(i) });
+		groupSupport.push_back(i);
+	}
+
+	for (std::size_t group = 0; group < groups.size(); ++group)
+	{
+		auto&                      inputSet = support[groupSupport[group]];
+		std::vector<std::uint32_t> inputs;
+		for (std::size_t input = inputSet.findFirstSet(); input != BitSet::c_NoBit; input = inputSet.findFirstSet(input + 1))
+			inputs.push_back(static_cast<std::uint32_t>(input));
+		if (inputs.size() > 16)
+		{
+			Log::Warn("Graph output {} depends on {} inputs, too many for a truth table", groups[group][0], inputs.size());
+			cones.invalidate();
+			return cones;
+		}
+
+		TruthTable truthTable = CompileTable(netlist, inputs, groups[group], pool);
+		cones.addCone({ std::move(inputs), std::move(groups[group]), std::move(truthTable) });
+	}
+	return cones;
+}
+
+static std::optional<TruthTable> CompileGraph(const Graph& graph, ThreadPool* pool)
+{
+	if (!graph.compilable())
+	{
+		Log::Warn("Graph with {} inputs is too wide for a truth table, use compileCones or compileDiagram instead", graph.inputCount());
+		return std::nullopt;
+	}
+
+	std::vector<std::uint32_t> inputs(graph.inputCount());
+	std::vector<std::uint32_t> outputs(graph.outputCount());
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		inputs[i] = static_cast<std::uint32_t>(i);
+	for (std::size_t i = 0; i < outputs.size(); ++i)
+		outputs[i] = static_cast<std::uint32_t>(i);
+	return CompileTable(Netlist { graph }, inputs, outputs, pool);
+}
+
+std::optional<TruthTable> Graph::compile() const
+{
+	return CompileGraph(*this, nullptr);
+}
+
+std::optional<TruthTable> Graph::compile(ThreadPool& pool) const
 {
-	if (!compilable())
-		return TruthTable { 1, 1, [](std::uint16_t inputs, std::size_t bit, BitSet& outputs)
-			                {
-			                    outputs.set(bit, inputs);
-			                } };
+	return CompileGraph(*this, &pool);
+}
 
-	GraphState state { *this };
-	return TruthTable { static_cast<std::uint8_t>(inputCount()), outputCount(), [&](std::uint16_t inputs, std::size_t bit, BitSet& outputs)
-		                {
-		                    state.setInputs({ static_cast<std::uint8_t>(inputs), static_cast<std::uint8_t>(inputs >> 8) });
-		                    // TODO(MarcasRealAccount): Maybe make Graph compilation better?
-		                    state.tick();
-		                    state.getOutputs(outputs, bit);
-		                } };
+ConeTable Graph::compileCones() const
+{
+	return CompileCones(*this, nullptr);
+}
+
+ConeTable Graph::compileCones(ThreadPool& pool) const
+{
+	return CompileCones(*this, &pool);
+}
+
+DecisionDiagram Graph::compileDiagram(std::size_t maxNodes) const
+{
+	Netlist         netlist { *this };
+	DecisionDiagram diagram { netlist, maxNodes };
+	if (!diagram.valid())
+		Log::Warn("Graph with {} inputs needs more than {} decision nodes", inputCount(), maxNodes);
+	return diagram;
+}
+
+std::uint64_t Graph::NextRevision()
+{
+	return RevisionSet::NextRevision();
 }
 
 void Graph::setPortConnection(Port port, std::size_t connection)
 {
 	if (port.m_Node.valid())
 	{
-		auto& r = *port.m_Node;
-
-		std::size_t inputLength = r.inputCount();
-		if (port.m_Port < inputLength)
-			r.getInputPorts()[port.m_Port] = connection;
-		else
-			r.getOutputPorts()[port.m_Port - inputLength] = connection;
+		m_NodePorts[port.m_Node->portOffset() + port.m_Port] = connection;
 	}
 	else
 	{
@@ -129,13 +293,7 @@ std::size_t Graph::getPortConnection(Port port) const
 {
 	if (port.m_Node.valid())
 	{
-		auto& r = *port.m_Node;
-
-		std::size_t inputLength = r.inputCount();
-		if (port.m_Port < inputLength)
-			return r.getInputPorts()[port.m_Port];
-		else
-			return r.getOutputPorts()[port.m_Port - inputLength];
+		return m_NodePorts[port.m_Node->portOffset() + port.m_Port];
 	}
 	else
 	{
@@ -145,4 +303,19 @@ std::size_t Graph::getPortConnection(Port port) const
 		else
 			return m_OutputPorts[port.m_Port - inputLength];
 	}
+}
+
+void Graph::compactNodePorts()
+{
+	// Blocks are laid out in node order, which is also the order the schedule walks them in
+	std::vector<std::size_t> ports;
+	ports.reserve(m_NodePorts.size() - m_UnusedNodePorts);
+	for (auto& node : m_Nodes)
+	{
+		auto begin         = m_NodePorts.begin() + node->m_PortOffset;
+		node->m_PortOffset = ports.size();
+		ports.insert(ports.end(), begin, begin + node->portCount());
+	}
+	m_NodePorts       = std::move(ports);
+	m_UnusedNodePorts = 0;
 }
\ No newline at end of file
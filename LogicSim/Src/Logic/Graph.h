@@ -1,52 +1,49 @@
 #pragma once
 
+#include "ConeTable.h"
+#include "DecisionDiagram.h"
 #include "ResourceManager/ResourceManager.h"
 #include "TruthTable.h"
 
+#include <optional>
+#include <span>
 #include <vector>
 
 struct Component;
+struct ThreadPool;
 
+// Port connections of every node are stored back to back in the owning Graph, inputs first, a node only records where its block starts.
 struct Node
 {
 public:
-	Node(ResourceManager::Ref<Component> component);
-	Node(Node&& move) noexcept
-	    : m_Component(std::move(move.m_Component)),
-	      m_InputPorts(std::move(move.m_InputPorts)),
-	      m_OutputPorts(std::move(move.m_OutputPorts)) {}
-	Node& operator=(Node&& move) noexcept
-	{
-		m_Component   = std::move(move.m_Component);
-		m_InputPorts  = std::move(move.m_InputPorts);
-		m_OutputPorts = std::move(move.m_OutputPorts);
-		return *this;
-	}
+	Node(ResourceManager::Ref<Component> component, std::size_t portOffset);
 
-	std::size_t inputCount() const { return m_InputPorts.size(); }
-	std::size_t outputCount() const { return m_OutputPorts.size(); }
+	std::size_t inputCount() const { return m_InputCount; }
+	std::size_t outputCount() const { return m_OutputCount; }
+	std::size_t portCount() const { return m_InputCount + m_OutputCount; }
+	std::size_t portOffset() const { return m_PortOffset; }
 
 	auto& getComponent() const { return m_Component; }
-	auto& getInputPorts() { return m_InputPorts; }
-	auto& getInputPorts() const { return m_InputPorts; }
-	auto& getOutputPorts() { return m_OutputPorts; }
-	auto& getOutputPorts() const { return m_OutputPorts; }
 
 private:
-	ResourceManager::Ref<Component> m_Component;
+	friend struct Graph;
 
-	std::vector<std::size_t> m_InputPorts;
-	std::vector<std::size_t> m_OutputPorts;
+	// Pinned, the simulation dereferences the component of every node on every tick
+	ResourceManager::PinnedRef<Component> m_Component;
+
+	std::size_t   m_PortOffset;
+	std::uint32_t m_InputCount;
+	std::uint32_t m_OutputCount;
 };
 
 struct Port
 {
 public:
-	Port(ResourceManager::ResourcePool<Node>::Ref node, std::size_t port)
+	Port(ResourceManager::SlotPool<Node>::Ref node, std::size_t port)
 	    : m_Node(node), m_Port(port) {}
 
 public:
-	ResourceManager::ResourcePool<Node>::Ref m_Node;
+	ResourceManager::SlotPool<Node>::Ref m_Node;
 
 	std::size_t m_Port;
 };
@@ -54,33 +51,53 @@ public:
 struct Graph
 {
 public:
-	using NodeRef = ResourceManager::ResourcePool<Node>::Ref;
+	using NodeRef      = ResourceManager::SlotPool<Node>::Ref;
+	using NodeResource = ResourceManager::SlotPool<Node>::Resource;
 
 public:
 	Graph(std::size_t numInputs, std::size_t numOutputs)
-	    : m_InputPorts(numInputs, ~0ULL),
+	    : m_UnusedNodePorts(0),
+	      m_InputPorts(numInputs, ~0ULL),
 	      m_OutputPorts(numOutputs, ~0ULL),
-	      m_NumConnections(0) {}
+	      m_NumConnections(0),
+	      m_Revision(NextRevision()) {}
 
 	NodeRef newNode(ResourceManager::Ref<Component> component);
-	void    removeNode(NodeRef node);
-	void    connect(Port a, Port b);
-	void    disconnect(Port a, Port b);
-
-	bool       compilable() const { return m_InputPorts.size() <= 16; }
-	TruthTable compile() const;
+	// Adds `count` nodes of the same component in one go, their indices are contiguous
+	std::vector<NodeRef> newNodes(ResourceManager::Ref<Component> component, std::size_t count);
+	void                 removeNode(NodeRef node);
+	void                 removeNodes(const std::vector<NodeRef>& nodes);
+	void                 connect(Port a, Port b);
+	void                 disconnect(Port a, Port b);
+
+	bool compilable() const { return m_InputPorts.size() <= 16; }
+	// Nothing unless compilable(), wider graphs go through compileCones() or compileDiagram()
+	std::optional<TruthTable> compile() const;
+	// Same as compile() but splits the input combinations across `pool`
+	std::optional<TruthTable> compile(ThreadPool& pool) const;
+	// One table per group of outputs sharing their input support, works past 16 inputs as long as every group stays within 16
+	ConeTable compileCones() const;
+	ConeTable compileCones(ThreadPool& pool) const;
+	// Works for any input count, as long as the outputs fit in `maxNodes` decision nodes
+	DecisionDiagram compileDiagram(std::size_t maxNodes = DecisionDiagram::c_DefaultMaxNodes) const;
 
 	std::size_t inputCount() const { return m_InputPorts.size(); }
 	std::size_t outputCount() const { return m_OutputPorts.size(); }
 	std::size_t connectionCount() const { return m_NumConnections; }
+	// Changes on every edit, revisions are unique across all graphs so a replaced graph never matches the one it replaced
+	std::uint64_t revision() const { return m_Revision; }
 
 	auto& getNodes() const { return m_Nodes; }
+	auto& getNodePorts() const { return m_NodePorts; }
 	auto& getInputPorts() const { return m_InputPorts; }
 	auto& getOutputPorts() const { return m_OutputPorts; }
 
+	std::span<const std::size_t> getInputPorts(const Node& node) const { return { m_NodePorts.data() + node.portOffset(), node.inputCount() }; }
+	std::span<const std::size_t> getOutputPorts(const Node& node) const { return { m_NodePorts.data() + node.portOffset() + node.inputCount(), node.outputCount() }; }
+
 	std::size_t allocatedSizeOf() const
 	{
-		return m_Nodes.allocatedSizeOf() + m_InputPorts.capacity() * sizeof(std::size_t) + m_OutputPorts.capacity() * sizeof(std::size_t);
+		return m_Nodes.allocatedSizeOf() + m_NodePorts.capacity() * sizeof(std::size_t) + m_InputPorts.capacity() * sizeof(std::size_t) + m_OutputPorts.capacity() * sizeof(std::size_t);
 	}
 
 	std::size_t totalSizeOf() const
@@ -89,14 +106,21 @@ public:
 	}
 
 private:
+	static std::uint64_t NextRevision();
+
 	void        setPortConnection(Port port, std::size_t connection);
 	std::size_t getPortConnection(Port port) const;
+	void        compactNodePorts();
 
 private:
-	ResourceManager::ResourcePool<Node> m_Nodes;
+	ResourceManager::SlotPool<Node> m_Nodes;
+	// Port connections of every node, removed nodes leave their block behind until more than half of the list is unused
+	std::vector<std::size_t> m_NodePorts;
+	std::size_t              m_UnusedNodePorts;
 
 	std::vector<std::size_t> m_InputPorts;
 	std::vector<std::size_t> m_OutputPorts;
 
-	std::size_t m_NumConnections;
+	std::size_t   m_NumConnections;
+	std::uint64_t m_Revision;
 };
\ No newline at end of file
@@ -1,96 +1,331 @@
 #include "GraphState.h"
 
+#include <algorithm>
+#include <functional>
+
 GraphState::GraphState(const Graph& graph)
     : m_Graph(graph),
       m_Connections(m_Graph.connectionCount()),
       m_Inputs(m_Graph.inputCount()),
-      m_Outputs(m_Graph.outputCount())
+      m_Outputs(m_Graph.outputCount()),
+      m_Schedule(m_Graph),
+      m_TickMode(TickMode::Full),
+      m_CurrentEvent(~0ULL),
+      m_SettleIterations(0),
+      m_SettleResult({ true, 0 }),
+      m_Changed(false)
 {
 	std::size_t maxOutputs = 0;
+	m_Revisions.addGraph(m_Graph);
 	for (auto& node : m_Graph.getNodes())
 	{
 		auto& component = node->getComponent();
+		m_Revisions.addComponent(component);
 		if (component->hasGraph())
-			m_GraphNodes.emplace(node.index(), component->getGraph());
+			m_Revisions.merge(std::move(m_GraphNodes.emplace(node.index(), component->getGraph())->m_State.m_Revisions));
 		else if (node->outputCount() > maxOutputs)
 			maxOutputs = node->outputCount();
 	}
+	m_Revisions.compact();
 
 	m_BuiltinOutputs.resize(maxOutputs);
+
+	auto& nodes = m_Graph.getNodes().resources();
+	m_Nodes.resize(m_Schedule.size());
+	for (std::size_t i = 0; i < m_Schedule.size(); ++i)
+		m_Nodes[i] = &nodes[m_Schedule[i]];
+}
+
+void GraphState::setTickMode(TickMode mode)
+{
+	if (mode == m_TickMode)
+		return;
+
+	m_TickMode = mode;
+	m_Events.clear();
+	m_DeferredEvents.clear();
+	m_QueuedEvents = BitSet(m_Schedule.size());
+	if (m_TickMode == TickMode::Event)
+	{
+		// Nothing is known about the current state, so the first tick has to evaluate everything
+		for (std::size_t i = 0; i < m_Schedule.size(); ++i)
+			queueEvent(i);
+	}
+
+	for (auto& graphNode : m_GraphNodes)
+		graphNode->m_State.setTickMode(mode);
 }
 
 void GraphState::tick()
 {
+	if (!refuseOutdated("tick"))
+		tickState();
+}
+
+SettleResult GraphState::settle(std::size_t maxIterations)
+{
+	if (refuseOutdated("settle"))
+		return { false, 0 };
+	return settleState(maxIterations);
+}
+
+void GraphState::tickState()
+{
+	loadInputs();
+
+	if (m_TickMode == TickMode::Event)
+	{
+		for (std::size_t index : m_DeferredEvents)
+		{
+			m_Events.push_back(index);
+			std::push_heap(m_Events.begin(), m_Events.end(), std::greater<> {});
+		}
+		m_DeferredEvents.clear();
+
+		// Schedule indices only ever fan out to higher indices, except inside feedback loops, so popping the lowest index keeps the levelized order
+		while (!m_Events.empty())
+		{
+			std::pop_heap(m_Events.begin(), m_Events.end(), std::greater<> {});
+			m_CurrentEvent = m_Events.back();
+			m_Events.pop_back();
+			m_QueuedEvents.set(m_CurrentEvent, false);
+			evaluateNode(m_CurrentEvent);
+		}
+		m_CurrentEvent = ~0ULL;
+	}
+	else
 	{
-		auto& inputPorts = m_Graph.getInputPorts();
+		for (std::size_t i = 0; i < m_Schedule.size(); ++i)
+			evaluateNode(i);
+	}
+
+	storeOutputs();
+}
+
+SettleResult GraphState::settleState(std::size_t maxIterations)
+{
+	m_SettleIterations = std::max<std::size_t>(maxIterations, 1);
+	m_SettleResult     = { true, 0 };
+
+	loadInputs();
+	for (std::size_t i = 0; i < m_Schedule.feedbackBegin(); ++i)
+		evaluateNode(i);
+
+	for (std::size_t component = 0; component < m_Schedule.componentCount(); ++component)
+	{
+		std::size_t begin = m_Schedule.componentBegin(component);
+		std::size_t end   = m_Schedule.componentEnd(component);
+		if (!m_Schedule.isCyclic(component))
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				evaluateNode(i);
+			continue;
+		}
+
+		// Iterate the loop until a full pass leaves every connection unchanged
+		std::size_t iterations = 0;
+		do
+		{
+			m_Changed = false;
+			for (std::size_t i = begin; i < end; ++i)
+				evaluateNode(i);
+			++iterations;
+		}
+		while (m_Changed && iterations < m_SettleIterations);
+
+		m_SettleResult.m_Settled    = m_SettleResult.m_Settled && !m_Changed;
+		m_SettleResult.m_Iterations = std::max(m_SettleResult.m_Iterations, iterations);
+	}
+	storeOutputs();
+
+	// Every node has seen its final inputs, nothing is left for the next event tick
+	if (m_TickMode == TickMode::Event)
+	{
+		m_Events.clear();
+		m_DeferredEvents.clear();
+		m_QueuedEvents = BitSet(m_Schedule.size());
+	}
+
+	m_SettleIterations = 0;
+	return m_SettleResult;
+}
+
+bool GraphState::refuseOutdated(std::string_view action) const
+{
+	if (!outdated())
+		return false;
+	Log::Warn("Refusing to {} a GraphState over an edited graph, rebuild it first", action);
+	return true;
+}
+
+void GraphState::loadInputs()
+{
+	auto& inputPorts = m_Graph.getInputPorts();
+	for (std::size_t i = 0; i < inputPorts.size(); ++i)
+	{
+		std::size_t connection = inputPorts[i];
+		if (connection == ~0ULL)
+			continue;
+		writeConnection(connection, m_Inputs.get(i));
+	}
+}
+
+void GraphState::storeOutputs()
+{
+	auto& outputPorts = m_Graph.getOutputPorts();
+	for (std::size_t i = 0; i < outputPorts.size(); ++i)
+	{
+		std::size_t connection = outputPorts[i];
+		bool        value      = false;
+		if (connection != ~0ULL)
+			value = m_Connections.get(connection);
+		m_Outputs.set(i, value);
+	}
+}
+
+void GraphState::evaluateNode(std::size_t index)
+{
+	auto& node        = *m_Nodes[index];
+	auto& component   = node->getComponent();
+	auto  inputPorts  = m_Graph.getInputPorts(*node);
+	auto  outputPorts = m_Graph.getOutputPorts(*node);
+
+	if (component->hasGate())
+	{
+		std::uint64_t inputs = 0;
 		for (std::size_t i = 0; i < inputPorts.size(); ++i)
 		{
 			std::size_t connection = inputPorts[i];
 			if (connection == ~0ULL)
 				continue;
-			m_Connections.set(connection, m_Inputs.get(i));
+			inputs |= static_cast<std::uint64_t>(m_Connections.get(connection)) << i;
 		}
+		if (outputPorts[0] != ~0ULL)
+			writeConnection(outputPorts[0], EvaluateGate(component->getGate(), inputs, inputPorts.size()));
 	}
-
-	for (auto& node : m_Graph.getNodes())
+	else if (component->hasTruthTable())
 	{
-		auto& component   = node->getComponent();
-		auto& inputPorts  = node->getInputPorts();
-		auto& outputPorts = node->getOutputPorts();
-
-		if (component->hasTruthTable())
+		std::uint16_t inputs = 0;
+		for (std::size_t i = 0; i < inputPorts.size(); ++i)
 		{
-			std::uint16_t inputs = 0;
-			for (std::size_t i = 0; i < inputPorts.size(); ++i)
-			{
-				std::size_t connection = inputPorts[i];
-				if (connection == ~0ULL)
-					continue;
-				inputs |= m_Connections.get(connection) << i;
-			}
-			component->getTruthTable().getOutput(inputs, m_BuiltinOutputs);
-			for (std::size_t i = 0; i < outputPorts.size(); ++i)
-			{
-				std::size_t connection = outputPorts[i];
-				if (connection == ~0ULL)
-					continue;
-				m_Connections.set(connection, m_BuiltinOutputs.get(i));
-			}
+			std::size_t connection = inputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			inputs |= m_Connections.get(connection) << i;
 		}
-		else if (component->hasGraph())
+		// Aligned tables hand back the whole row in one word, only wide tables go through the generic bit copy
+		auto&         truthTable = component->getTruthTable();
+		bool          aligned    = truthTable.isAligned();
+		std::uint64_t row        = 0;
+		if (aligned)
+			row = truthTable.getRow(inputs);
+		else
+			truthTable.getOutput(inputs, m_BuiltinOutputs);
+		for (std::size_t i = 0; i < outputPorts.size(); ++i)
 		{
-			auto graphState = m_GraphNodes.getResource(node.index());
-			if (!graphState)
-				break;
-			auto& inputs  = graphState->m_State.m_Inputs;
-			auto& outputs = graphState->m_State.m_Outputs;
-			for (std::size_t i = 0; i < inputPorts.size(); ++i)
-			{
-				std::size_t connection = inputPorts[i];
-				if (connection == ~0ULL)
-					continue;
-				inputs.set(i, m_Connections.get(connection));
-			}
-			graphState->m_State.tick();
-			for (std::size_t i = 0; i < outputPorts.size(); ++i)
-			{
-				std::size_t connection = outputPorts[i];
-				if (connection == ~0ULL)
-					continue;
-				m_Connections.set(connection, outputs.get(i));
-			}
+			std::size_t connection = outputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			writeConnection(connection, aligned ? (row >> i) & 1 : m_BuiltinOutputs.get(i));
 		}
 	}
-
+	else if (component->hasConeTable())
 	{
-		auto& outputPorts = m_Graph.getOutputPorts();
-		for (std::size_t i = 0; i < outputPorts.size(); ++i)
+		auto input = [this, &inputPorts](std::size_t i)
+		{
+			std::size_t connection = inputPorts[i];
+			return connection != ~0ULL && m_Connections.get(connection);
+		};
+		auto output = [this, &outputPorts](std::size_t i, bool value)
 		{
 			std::size_t connection = outputPorts[i];
-			bool        value      = false;
 			if (connection != ~0ULL)
-				value = m_Connections.get(connection);
-			m_Outputs.set(i, value);
+				writeConnection(connection, value);
+		};
+		component->getConeTable().evaluate(input, output);
+	}
+	else if (component->hasDecisionDiagram())
+	{
+		auto& diagram = component->getDecisionDiagram();
+		auto  input   = [this, &inputPorts](std::size_t i)
+		{
+			std::size_t connection = inputPorts[i];
+			return connection != ~0ULL && m_Connections.get(connection);
+		};
+		for (std::size_t i = 0; i < outputPorts.size(); ++i)
+		{
+			std::size_t connection = outputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			writeConnection(connection, diagram.getOutput(i, input));
+		}
+	}
+	else if (component->hasGraph())
+	{
+		auto graphState = m_GraphNodes.getResource(node.index());
+		if (!graphState)
+			return;
+		auto& inputs  = graphState->m_State.m_Inputs;
+		auto& outputs = graphState->m_State.m_Outputs;
+		for (std::size_t i = 0; i < inputPorts.size(); ++i)
+		{
+			std::size_t connection = inputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			inputs.set(i, m_Connections.get(connection));
+		}
+		if (m_SettleIterations != 0)
+		{
+			SettleResult result        = graphState->m_State.settleState(m_SettleIterations);
+			m_SettleResult.m_Settled    = m_SettleResult.m_Settled && result.m_Settled;
+			m_SettleResult.m_Iterations = std::max(m_SettleResult.m_Iterations, result.m_Iterations);
+		}
+		else
+		{
+			graphState->m_State.tickState();
 		}
+		for (std::size_t i = 0; i < outputPorts.size(); ++i)
+		{
+			std::size_t connection = outputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			writeConnection(connection, outputs.get(i));
+		}
+
+		// Feedback inside the nested graph hasn't settled yet, revisit it next tick
+		if (m_TickMode == TickMode::Event && graphState->m_State.hasPendingEvents())
+			queueEvent(index);
+	}
+}
+
+void GraphState::writeConnection(std::size_t connection, bool value)
+{
+	if (m_Connections.get(connection) == value)
+		return;
+
+	m_Changed = true;
+	if (m_TickMode == TickMode::Event)
+	{
+		for (std::size_t i = m_Schedule.fanoutBegin(connection); i < m_Schedule.fanoutEnd(connection); ++i)
+			queueEvent(m_Schedule.fanout(i));
+	}
+	m_Connections.set(connection, value);
+}
+
+void GraphState::queueEvent(std::size_t index)
+{
+	if (m_QueuedEvents.get(index))
+		return;
+
+	m_QueuedEvents.set(index, true);
+	if (m_CurrentEvent != ~0ULL && index <= m_CurrentEvent)
+	{
+		// Only reachable through feedback, evaluate once per tick like a full tick would
+		m_DeferredEvents.push_back(index);
+	}
+	else
+	{
+		m_Events.push_back(index);
+		std::push_heap(m_Events.begin(), m_Events.end(), std::greater<> {});
 	}
 }
\ No newline at end of file
@@ -3,29 +3,66 @@
 #include "Component.h"
 #include "Graph.h"
 #include "ResourceManager/ResourceManager.h"
+#include "RevisionSet.h"
+#include "Schedule.h"
 #include "Utils/BitSet.h"
 
+#include <bit>
+#include <string_view>
+
 struct GraphNode;
 
+enum class TickMode
+{
+	Full, // Evaluate every node on every tick
+	Event // Only evaluate nodes whose inputs changed since the last tick
+};
+
+struct SettleResult
+{
+public:
+	bool        m_Settled;    // False when a feedback loop was still changing after the iteration limit
+	std::size_t m_Iterations; // Most iterations any single feedback loop needed
+};
+
 struct GraphState
 {
 public:
 	GraphState(const Graph& graph);
 	GraphState(GraphState&& move) noexcept
 	    : m_Graph(move.m_Graph),
+	      m_Revisions(std::move(move.m_Revisions)),
 	      m_Connections(std::move(move.m_Connections)),
 	      m_Inputs(std::move(move.m_Inputs)),
 	      m_Outputs(std::move(move.m_Outputs)),
 	      m_BuiltinOutputs(std::move(move.m_BuiltinOutputs)),
+	      m_Schedule(std::move(move.m_Schedule)),
+	      m_Nodes(std::move(move.m_Nodes)),
+	      m_TickMode(move.m_TickMode),
+	      m_Events(std::move(move.m_Events)),
+	      m_DeferredEvents(std::move(move.m_DeferredEvents)),
+	      m_QueuedEvents(std::move(move.m_QueuedEvents)),
+	      m_CurrentEvent(move.m_CurrentEvent),
+	      m_SettleIterations(0),
+	      m_SettleResult({ true, 0 }),
+	      m_Changed(false),
 	      m_GraphNodes(std::move(move.m_GraphNodes)) {}
 	GraphState& operator=(GraphState&& move) noexcept
 	{
 		*std::bit_cast<const Graph**>(this) = &move.m_Graph;
 
+		m_Revisions      = std::move(move.m_Revisions);
 		m_Connections    = std::move(move.m_Connections);
 		m_Inputs         = std::move(move.m_Inputs);
 		m_Outputs        = std::move(move.m_Outputs);
 		m_BuiltinOutputs = std::move(move.m_BuiltinOutputs);
+		m_Schedule       = std::move(move.m_Schedule);
+		m_Nodes          = std::move(move.m_Nodes);
+		m_TickMode       = move.m_TickMode;
+		m_Events         = std::move(move.m_Events);
+		m_DeferredEvents = std::move(move.m_DeferredEvents);
+		m_QueuedEvents   = std::move(move.m_QueuedEvents);
+		m_CurrentEvent   = move.m_CurrentEvent;
 		m_GraphNodes     = std::move(move.m_GraphNodes);
 		return *this;
 	}
@@ -35,21 +72,38 @@ public:
 		m_Inputs.set(bit, value);
 	}
 
-	void setInputs(const BitSet& values, std::size_t offset = 0, std::size_t start = 0, std::size_t count = ~0ULL)
+	// Copies bits starting at `offset` of `values` to the inputs starting at `start`, any BitSet or slice of a caller owned buffer can be passed
+	void setInputs(ConstBitSpan values, std::size_t offset = 0, std::size_t start = 0, std::size_t count = ~0ULL)
 	{
-		m_Inputs.setBits(values, offset, start, std::min(count, m_Inputs.size()));
+		m_Inputs.setBits(values, offset, start, count);
 	}
 
-	void getOutputs(BitSet& result, std::size_t offset = 0, std::size_t start = 0, std::size_t count = ~0ULL)
+	void getOutputs(BitSpan result, std::size_t offset = 0, std::size_t start = 0, std::size_t count = ~0ULL) const
 	{
-		m_Outputs.getBits(result, offset, start, std::min(count, m_Outputs.size()));
+		m_Outputs.getBits(result, offset, start, count);
 	}
 
+	// Switching to TickMode::Event evaluates every node on the next tick, afterwards only the fanout of changed connections is evaluated
+	void     setTickMode(TickMode mode);
+	TickMode getTickMode() const { return m_TickMode; }
+	bool     hasPendingEvents() const { return !m_DeferredEvents.empty(); }
+
+	// Evaluates every node once in levelized order, a combinational graph is fully settled after a single tick.
+	// Does nothing but warn when outdated(), the node storage of an edited graph may have been freed
 	void tick();
+	// Like tick(), but iterates every feedback loop until its connections stop changing, nested graphs settle as well.
+	// Only the strongly connected components of the schedule are iterated, the levelized part is still evaluated once
+	SettleResult settle(std::size_t maxIterations = 64);
+
+	// True once the graph or any nested graph was edited or a component of them was removed after this state was built, the state has to be rebuilt before it ticks again.
+	// Nested states hand their revisions to the outermost one, so this only compares revisions after some graph or component was edited since the last check
+	bool outdated() const { return m_Revisions.outdated(); }
+
+	auto& getSchedule() const { return m_Schedule; }
 
 	std::size_t allocatedSizeOf() const
 	{
-		return m_Graph.allocatedSizeOf() + m_Connections.allocatedSizeOf() + m_Inputs.allocatedSizeOf() + m_Outputs.allocatedSizeOf() + m_BuiltinOutputs.allocatedSizeOf() + m_GraphNodes.allocatedSizeOf();
+		return m_Graph.allocatedSizeOf() + m_Connections.allocatedSizeOf() + m_Inputs.allocatedSizeOf() + m_Outputs.allocatedSizeOf() + m_BuiltinOutputs.allocatedSizeOf() + m_Schedule.allocatedSizeOf() + m_Nodes.capacity() * sizeof(const Graph::NodeResource*) + (m_Events.capacity() + m_DeferredEvents.capacity()) * sizeof(std::size_t) + m_QueuedEvents.allocatedSizeOf() + m_GraphNodes.allocatedSizeOf() + m_Revisions.allocatedSizeOf();
 	}
 
 	std::size_t totalSizeOf() const
@@ -58,13 +112,42 @@ public:
 	}
 
 private:
-	const Graph& m_Graph;
-	BitSet       m_Connections;
-	BitSet       m_Inputs;
-	BitSet       m_Outputs;
-	BitSet       m_BuiltinOutputs;
+	// tick() and settle() without the outdated() check, nested states are covered by the check of the outermost state
+	void         tickState();
+	SettleResult settleState(std::size_t maxIterations);
+	// Warns and returns true when outdated(), `action` names the refused call
+	bool refuseOutdated(std::string_view action) const;
+
+	void loadInputs();
+	void storeOutputs();
+
+	void evaluateNode(std::size_t index);
+	void writeConnection(std::size_t connection, bool value);
+	void queueEvent(std::size_t index);
+
+private:
+	const Graph&  m_Graph;
+	RevisionSet   m_Revisions;
+	BitSet        m_Connections;
+	BitSet        m_Inputs;
+	BitSet        m_Outputs;
+	BitSet        m_BuiltinOutputs;
+	Schedule      m_Schedule;
+	// Nodes in schedule order, node storage is chunked so these stay valid for as long as the graph is not edited
+	std::vector<const Graph::NodeResource*> m_Nodes;
+
+	TickMode                 m_TickMode;
+	std::vector<std::size_t> m_Events;
+	std::vector<std::size_t> m_DeferredEvents;
+	BitSet                   m_QueuedEvents;
+	std::size_t              m_CurrentEvent;
+
+	// Iteration limit while settling, 0 during a normal tick
+	std::size_t  m_SettleIterations;
+	SettleResult m_SettleResult;
+	bool         m_Changed;
 
-	ResourceManager::ResourcePool<GraphNode> m_GraphNodes;
+	ResourceManager::SlotPool<GraphNode> m_GraphNodes;
 };
 
 struct GraphNode
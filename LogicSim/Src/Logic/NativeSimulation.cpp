@@ -0,0 +1,399 @@
+#include "NativeSimulation.h"
+#include "GraphState.h"
+#include "Utils/Core.h"
+#include "Utils/Log.h"
+
+#include <cctype>
+#include <cstdlib>
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#if BUILD_IS_SYSTEM_WINDOWS
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+//-----------------
+// Code generation
+//-----------------
+
+struct SourceWriter
+{
+public:
+	SourceWriter(const Netlist& netlist)
+	    : m_Netlist(netlist),
+	      m_Declared(netlist.connectionCount(), false),
+	      m_Temporaries(0) {}
+
+	std::string connection(std::size_t connection) const
+	{
+		return connection == Netlist::c_ZeroConnection ? "0ULL" : "c" + std::to_string(connection);
+	}
+
+	std::string temporary(const std::string& expression)
+	{
+		std::string name = "t" + std::to_string(m_Temporaries++);
+		m_Body << "\tstd::uint64_t " << name << " = " << expression << ";\n";
+		return name;
+	}
+
+	void assign(std::size_t connection, const std::string& expression)
+	{
+		if (connection == Netlist::c_SinkConnection)
+			return;
+		m_Body << '\t' << (m_Declared[connection] ? "" : "std::uint64_t ") << "c" << connection << " = " << expression << ";\n";
+		m_Declared[connection] = true;
+	}
+
+	std::string join(std::span<const std::size_t> inputs, std::string_view separator) const
+	{
+		std::string expression;
+		for (std::size_t i = 0; i < inputs.size(); ++i)
+		{
+			if (i > 0)
+				expression += separator;
+			expression += connection(inputs[i]);
+		}
+		return inputs.size() > 1 ? "(" + expression + ")" : expression;
+	}
+
+	void emit(const NetlistInstruction& instruction)
+	{
+		auto inputs  = m_Netlist.getInputs(instruction);
+		auto outputs = m_Netlist.getOutputs(instruction);
+		switch (instruction.m_Op)
+		{
+		case GateOp::Table:
+			for (std::size_t output = 0; output < outputs.size(); ++output)
+				if (outputs[output] != Netlist::c_SinkConnection)
+					assign(outputs[output], emitTable(*instruction.m_TruthTable, output, inputs, inputs.size(), 0));
+			break;
+		case GateOp::Buffer:
+		case GateOp::And: assign(outputs[0], join(inputs, " & ")); break;
+		case GateOp::Nand: assign(outputs[0], "~" + join(inputs, " & ")); break;
+		case GateOp::Or: assign(outputs[0], join(inputs, " | ")); break;
+		case GateOp::Nor: assign(outputs[0], "~" + join(inputs, " | ")); break;
+		case GateOp::Xor:
+		case GateOp::Xnor:
+		{
+			// Exactly one input high, tracked as "at least one" and "at least two"
+			std::string one  = temporary(connection(inputs[0]));
+			std::string many = temporary("0ULL");
+			for (std::size_t i = 1; i < inputs.size(); ++i)
+			{
+				m_Body << '\t' << many << " |= " << one << " & " << connection(inputs[i]) << ";\n";
+				m_Body << '\t' << one << " |= " << connection(inputs[i]) << ";\n";
+			}
+			assign(outputs[0], instruction.m_Op == GateOp::Xor ? one + " & ~" + many : "~" + one + " | " + many);
+			break;
+		}
+		}
+	}
+
+	// Mux tree over rows [base, base + 2^count) selecting on input count - 1, constant subtrees fold away
+	std::string emitTable(const TruthTable& truthTable, std::size_t output, std::span<const std::size_t> inputs, std::size_t count, std::uint32_t base)
+	{
+		if (count == 0)
+			return truthTable.getOutput(static_cast<std::uint16_t>(base), output) ? "~0ULL" : "0ULL";
+
+		std::string low    = emitTable(truthTable, output, inputs, count - 1, base);
+		std::string high   = emitTable(truthTable, output, inputs, count - 1, base + (1U << (count - 1)));
+		std::string select = connection(inputs[count - 1]);
+		if (low == high)
+			return low;
+		if (low == "0ULL" && high == "~0ULL")
+			return select;
+		if (low == "~0ULL" && high == "0ULL")
+			return "~" + select;
+		if (low == "0ULL")
+			return temporary(select + " & " + high);
+		if (high == "0ULL")
+			return temporary("~" + select + " & " + low);
+		if (low == "~0ULL")
+			return temporary("~" + select + " | " + high);
+		if (high == "~0ULL")
+			return temporary(select + " | " + low);
+		return temporary("(" + select + " & " + high + ") | (~" + select + " & " + low + ")");
+	}
+
+public:
+	const Netlist&     m_Netlist;
+	std::vector<bool>  m_Declared;
+	std::ostringstream m_Body;
+	std::size_t        m_Temporaries;
+};
+
+std::string NativeSimulation::GenerateSource(const Netlist& netlist, std::string_view symbol)
+{
+	auto& instructions = netlist.getInstructions();
+	auto& inputs       = netlist.getInputs();
+	auto& outputs      = netlist.getOutputs();
+
+	// Connections read before they are written in schedule order carry their value over from the previous call through the caller's state
+	std::vector<bool> written(netlist.connectionCount(), false);
+	std::vector<bool> state(netlist.connectionCount(), false);
+	written[Netlist::c_ZeroConnection] = true;
+	written[Netlist::c_SinkConnection] = true;
+	for (std::size_t connection : inputs)
+		written[connection] = true;
+	for (auto& instruction : instructions)
+	{
+		for (std::size_t connection : netlist.getInputs(instruction))
+			state[connection] = state[connection] || !written[connection];
+		for (std::size_t connection : netlist.getOutputs(instruction))
+			written[connection] = true;
+	}
+
+	SourceWriter writer { netlist };
+	std::size_t  stateCount = 0;
+	for (std::size_t connection = 0; connection < state.size(); ++connection)
+		if (state[connection])
+			writer.assign(connection, "state[" + std::to_string(stateCount++) + "]");
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		writer.assign(inputs[i], "in[" + std::to_string(i) + "]");
+	for (auto& instruction : instructions)
+		writer.emit(instruction);
+	for (std::size_t i = 0; i < outputs.size(); ++i)
+		writer.m_Body << "\tout[" << i << "] = " << writer.connection(outputs[i]) << ";\n";
+	for (std::size_t connection = 0, slot = 0; connection < state.size(); ++connection)
+		if (state[connection])
+			writer.m_Body << "\tstate[" << slot++ << "] = c" << connection << ";\n";
+
+	std::ostringstream source;
+	source << "// Generated by LogicSim from a netlist with " << instructions.size() << " instructions, do not edit\n"
+	       << "#include <cstddef>\n"
+	       << "#include <cstdint>\n\n"
+	       << "#if defined(_WIN32)\n"
+	       << "#define LOGICSIM_EXPORT extern \"C\" __declspec(dllexport)\n"
+	       << "#else\n"
+	       << "#define LOGICSIM_EXPORT extern \"C\" __attribute__((visibility(\"default\")))\n"
+	       << "#endif\n\n"
+	       << "LOGICSIM_EXPORT const std::size_t " << symbol << "_inputCount  = " << inputs.size() << ";\n"
+	       << "LOGICSIM_EXPORT const std::size_t " << symbol << "_outputCount = " << outputs.size() << ";\n"
+	       << "LOGICSIM_EXPORT const std::size_t " << symbol << "_stateCount  = " << stateCount << ";\n\n"
+	       << "LOGICSIM_EXPORT void " << symbol << "(const std::uint64_t* in, std::uint64_t* out, std::uint64_t* state)\n{\n"
+	       << "\t(void) in;\n"
+	       << "\t(void) state;\n"
+	       << writer.m_Body.str()
+	       << "}\n";
+	return source.str();
+}
+
+//----------------
+// Shared library
+//----------------
+
+// Names end up in file names, generated declarations and symbol lookups, so only plain C identifiers are accepted
+static bool IsIdentifier(std::string_view name)
+{
+	if (name.empty() || !(std::isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_'))
+		return false;
+	return std::all_of(name.begin(), name.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+}
+
+// Quotes a path as a single argument of the shell std::system runs
+static std::string QuoteArgument(const std::filesystem::path& path)
+{
+	std::string argument = path.string();
+#if BUILD_IS_SYSTEM_WINDOWS
+	// Paths can't contain quotes on Windows, build() rejects the % that cmd would still expand within them.
+	// A trailing backslash would escape the closing quote, so it is doubled
+	if (!argument.empty() && argument.back() == '\\')
+		argument += '\\';
+	return "\"" + argument + "\"";
+#else
+	std::string quoted = "'";
+	for (char c : argument)
+		quoted += c == '\'' ? std::string { "'\\''" } : std::string { c };
+	return quoted + "'";
+#endif
+}
+
+NativeSimulation::NativeSimulation()
+    : m_Library(nullptr),
+      m_Evaluate(nullptr),
+      m_InputCount(0),
+      m_OutputCount(0) {}
+
+NativeSimulation::NativeSimulation(NativeSimulation&& move) noexcept
+    : m_Library(move.m_Library),
+      m_Evaluate(move.m_Evaluate),
+      m_InputCount(move.m_InputCount),
+      m_OutputCount(move.m_OutputCount),
+      m_State(std::move(move.m_State))
+{
+	move.m_Library  = nullptr;
+	move.m_Evaluate = nullptr;
+}
+
+NativeSimulation::~NativeSimulation()
+{
+	unload();
+}
+
+NativeSimulation& NativeSimulation::operator=(NativeSimulation&& move) noexcept
+{
+	unload();
+	m_Library       = move.m_Library;
+	m_Evaluate      = move.m_Evaluate;
+	m_InputCount    = move.m_InputCount;
+	m_OutputCount   = move.m_OutputCount;
+	m_State         = std::move(move.m_State);
+	move.m_Library  = nullptr;
+	move.m_Evaluate = nullptr;
+	return *this;
+}
+
+bool NativeSimulation::build(const Netlist& netlist, const std::filesystem::path& directory, std::string_view name, std::string_view symbol)
+{
+	if (!IsIdentifier(name) || !IsIdentifier(symbol))
+	{
+		Log::Warn("Native simulation name '{}' and symbol '{}' have to be plain identifiers", name, symbol);
+		return false;
+	}
+#if BUILD_IS_SYSTEM_WINDOWS
+	if (directory.string().find('%') != std::string::npos)
+	{
+		Log::Warn("Native simulation directory '{}' can't be passed to cl, it contains a '%'", directory.string());
+		return false;
+	}
+#endif
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+
+	std::filesystem::path sourcePath = directory / (std::string { name } + ".cpp");
+	{
+		std::ofstream file { sourcePath, std::ios::binary };
+		if (!file)
+		{
+			Log::Warn("Failed to write native simulation source '{}'", sourcePath.string());
+			return false;
+		}
+		file << GenerateSource(netlist, symbol);
+	}
+
+#if BUILD_IS_SYSTEM_WINDOWS
+	std::filesystem::path libraryPath = directory / (std::string { name } + ".dll");
+	std::string           command     = "cl /nologo /O2 /LD " + QuoteArgument(sourcePath) + " /Fe" + QuoteArgument(libraryPath) + " /Fo" + QuoteArgument(directory / "");
+#else
+#if BUILD_IS_SYSTEM_MACOSX
+	std::filesystem::path libraryPath = directory / (std::string { name } + ".dylib");
+#else
+	std::filesystem::path libraryPath = directory / (std::string { name } + ".so");
+#endif
+	const char* compiler = std::getenv("CXX");
+	std::string command  = std::string { compiler ? compiler : "c++" } + " -std=c++17 -O2 -shared -fPIC " + QuoteArgument(sourcePath) + " -o " + QuoteArgument(libraryPath);
+#endif
+
+	if (std::system(command.c_str()) != 0)
+	{
+		Log::Warn("Failed to compile native simulation with '{}'", command);
+		return false;
+	}
+	return load(libraryPath, symbol);
+}
+
+bool NativeSimulation::load(const std::filesystem::path& library, std::string_view symbol)
+{
+	unload();
+	if (!IsIdentifier(symbol))
+	{
+		Log::Warn("Native simulation symbol '{}' has to be a plain identifier", symbol);
+		return false;
+	}
+
+#if BUILD_IS_SYSTEM_WINDOWS
+	HMODULE module = LoadLibraryW(library.c_str());
+	auto    lookup = [module](const std::string& name) { return reinterpret_cast<void*>(GetProcAddress(module, name.c_str())); };
+#else
+	void* module = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+	auto  lookup = [module](const std::string& name) { return dlsym(module, name.c_str()); };
+#endif
+	if (!module)
+	{
+		Log::Warn("Failed to load native simulation '{}'", library.string());
+		return false;
+	}
+
+	std::string name { symbol };
+	m_Library         = module;
+	m_Evaluate        = reinterpret_cast<EvaluateFunction>(lookup(name));
+	auto* inputCount  = static_cast<const std::size_t*>(lookup(name + "_inputCount"));
+	auto* outputCount = static_cast<const std::size_t*>(lookup(name + "_outputCount"));
+	auto* stateCount  = static_cast<const std::size_t*>(lookup(name + "_stateCount"));
+	if (!m_Evaluate || !inputCount || !outputCount || !stateCount)
+	{
+		Log::Warn("Native simulation '{}' is missing the '{}' entry points", library.string(), name);
+		unload();
+		return false;
+	}
+	m_InputCount  = *inputCount;
+	m_OutputCount = *outputCount;
+	m_State.assign(*stateCount, 0);
+	return true;
+}
+
+void NativeSimulation::unload()
+{
+	if (!m_Library)
+		return;
+
+#if BUILD_IS_SYSTEM_WINDOWS
+	FreeLibrary(static_cast<HMODULE>(m_Library));
+#else
+	dlclose(m_Library);
+#endif
+	m_Library     = nullptr;
+	m_Evaluate    = nullptr;
+	m_InputCount  = 0;
+	m_OutputCount = 0;
+	m_State.clear();
+}
+
+bool NativeSimulation::verify(const Graph& graph, std::size_t ticks, std::uint64_t seed) const
+{
+	if (!isLoaded() || graph.inputCount() != m_InputCount || graph.outputCount() != m_OutputCount)
+		return false;
+
+	// One reference state per lane, so graphs with feedback are compared over the same input sequence
+	std::vector<GraphState> states;
+	states.reserve(64);
+	for (std::size_t lane = 0; lane < 64; ++lane)
+		states.emplace_back(graph);
+	std::vector<Word> state(m_State.size(), 0);
+
+	std::mt19937_64   random { seed };
+	std::vector<Word> inputs(m_InputCount);
+	std::vector<Word> outputs(m_OutputCount);
+	BitSet            result(m_OutputCount);
+	for (std::size_t tick = 0; tick < ticks; ++tick)
+	{
+		for (auto& input : inputs)
+			input = random();
+		evaluate(inputs.data(), outputs.data(), state.data());
+
+		for (std::size_t lane = 0; lane < 64; ++lane)
+		{
+			auto& state = states[lane];
+			for (std::size_t i = 0; i < m_InputCount; ++i)
+				state.setInput(i, (inputs[i] >> lane) & 1);
+			state.tick();
+			state.getOutputs(result);
+			for (std::size_t o = 0; o < m_OutputCount; ++o)
+			{
+				if (result.get(o) != static_cast<bool>((outputs[o] >> lane) & 1))
+				{
+					Log::Warn("Native simulation differs from GraphState on tick {} lane {} output {}", tick, lane, o);
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Graph.h"
+#include "Netlist.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Netlist compiled to native code.
+// GenerateSource emits a standalone translation unit with a straight line `extern "C" void <symbol>(const std::uint64_t* in, std::uint64_t* out, std::uint64_t* state)`,
+// where every bit of in[i] and out[o] belongs to an independent pattern, matching a single word PatternState.
+// Connections of feedback loops carry over between calls in `state`, `<symbol>_stateCount` words owned by the caller and zeroed to reset, so the function itself keeps no state.
+// The unit can be linked into a benchmark directly or built into a shared library with the system compiler and loaded at runtime.
+struct NativeSimulation
+{
+public:
+	using Word             = std::uint64_t;
+	using EvaluateFunction = void (*)(const Word* in, Word* out, Word* state);
+
+	static std::string GenerateSource(const Netlist& netlist, std::string_view symbol = "evaluate");
+
+public:
+	NativeSimulation();
+	NativeSimulation(NativeSimulation&& move) noexcept;
+	NativeSimulation(const NativeSimulation&) = delete;
+	~NativeSimulation();
+
+	NativeSimulation& operator=(NativeSimulation&& move) noexcept;
+	NativeSimulation& operator=(const NativeSimulation&) = delete;
+
+	// Writes the generated source to `directory`, compiles it into a shared library with the system compiler and loads it.
+	// `name` and `symbol` have to be plain C identifiers, anything else is refused before a file is written
+	bool build(const Netlist& netlist, const std::filesystem::path& directory, std::string_view name = "LogicSimNative", std::string_view symbol = "evaluate");
+	// Looks up `symbol` and its `_inputCount`, `_outputCount` and `_stateCount` companions, as emitted by GenerateSource
+	bool load(const std::filesystem::path& library, std::string_view symbol = "evaluate");
+	void unload();
+
+	// Checks every lane against GraphState over `ticks` random input words, starting both from a reset state. Runs on its own state, the one of this instance is left as is
+	bool verify(const Graph& graph, std::size_t ticks = 16, std::uint64_t seed = 0) const;
+
+	// Evaluates with the state owned by this instance, instances loaded from the same library run independently
+	void evaluate(const Word* in, Word* out) { m_Evaluate(in, out, m_State.data()); }
+	// Evaluates with a caller owned state of stateCount() words, so one loaded library can run from several threads
+	void evaluate(const Word* in, Word* out, Word* state) const { m_Evaluate(in, out, state); }
+	void reset() { std::fill(m_State.begin(), m_State.end(), 0); }
+
+	bool        isLoaded() const { return m_Evaluate; }
+	std::size_t inputCount() const { return m_InputCount; }
+	std::size_t outputCount() const { return m_OutputCount; }
+	std::size_t stateCount() const { return m_State.size(); }
+
+private:
+	void*            m_Library;
+	EvaluateFunction  m_Evaluate;
+	std::size_t       m_InputCount;
+	std::size_t       m_OutputCount;
+	std::vector<Word> m_State;
+};
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "Netlist.h"
+#include "Component.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+GateOp Netlist::ClassifyTruthTable(const TruthTable& truthTable)
+{
+	std::size_t inputCount = truthTable.inputCount();
+	if (truthTable.outputCount() != 1 || inputCount < 1)
+		return GateOp::Table;
+
+	std::uint32_t rows    = 1U << inputCount;
+	std::uint32_t allHigh = rows - 1;
+
+	bool isAnd = true, isOr = true, isNand = true, isNor = true, isXor = true, isXnor = true;
+	for (std::uint32_t row = 0; row < rows; ++row)
+	{
+		bool value = truthTable.getOutput(static_cast<std::uint16_t>(row), 0);
+		bool one   = std::popcount(row) == 1;
+
+		isAnd  = isAnd && value == (row == allHigh);
+		isOr   = isOr && value == (row != 0);
+		isNand = isNand && value == (row != allHigh);
+		isNor  = isNor && value == (row == 0);
+		isXor  = isXor && value == one;
+		isXnor = isXnor && value == !one;
+	}
+
+	if (isAnd)
+		return GateOp::And;
+	if (isOr)
+		return GateOp::Or;
+	if (isNand)
+		return GateOp::Nand;
+	if (isNor)
+		return GateOp::Nor;
+	if (isXor)
+		return GateOp::Xor;
+	if (isXnor)
+		return GateOp::Xnor;
+	return GateOp::Table;
+}
+
+Netlist::Netlist(const Graph& graph)
+    : m_ConnectionCount(2)
+{
+	std::vector<std::size_t> connections(graph.connectionCount());
+	for (auto& connection : connections)
+		connection = m_ConnectionCount++;
+	m_Revisions.addGraph(graph);
+	flatten(graph, connections);
+
+	auto& inputPorts  = graph.getInputPorts();
+	auto& outputPorts = graph.getOutputPorts();
+	m_Inputs.resize(inputPorts.size());
+	m_Outputs.resize(outputPorts.size());
+	for (std::size_t i = 0; i < inputPorts.size(); ++i)
+		m_Inputs[i] = inputPorts[i] != ~0ULL ? connections[inputPorts[i]] : c_SinkConnection;
+	for (std::size_t i = 0; i < outputPorts.size(); ++i)
+		m_Outputs[i] = outputPorts[i] != ~0ULL ? connections[outputPorts[i]] : c_ZeroConnection;
+
+	m_Revisions.compact();
+
+	auto buildSchedule = [this]()
+	{
+		return Schedule {
+			m_Instructions.size(), m_ConnectionCount,
+			[this](std::size_t i) { return getInputs(m_Instructions[i]); },
+			[this](std::size_t i) { return getOutputs(m_Instructions[i]); }
+		};
+	};
+
+	// Connections driven by more than one instruction, the last writer in evaluation order wins
+	std::vector<std::uint32_t> writers(m_ConnectionCount, 0);
+	for (auto& instruction : m_Instructions)
+		for (std::size_t connection : getOutputs(instruction))
+			if (connection != c_SinkConnection)
+				++writers[connection];
+	auto sharesOutput = [&](const NetlistInstruction& instruction)
+	{
+		auto outputs = getOutputs(instruction);
+		return std::any_of(outputs.begin(), outputs.end(), [&](std::size_t connection) { return connection != c_SinkConnection && writers[connection] > 1; });
+	};
+
+	// Store the instructions in levelized order, so evaluation streams through them linearly.
+	// Within a level the instructions writing a shared connection go last, they have to be evaluated in order on a single thread.
+	Schedule                        schedule = buildSchedule();
+	std::vector<NetlistInstruction> instructions;
+	std::vector<std::size_t>        operands;
+	instructions.reserve(m_Instructions.size());
+	operands.reserve(m_Operands.size());
+	auto append = [&](std::size_t index)
+	{
+		NetlistInstruction instruction = m_Instructions[index];
+		auto               begin       = m_Operands.begin() + instruction.m_Operands;
+		instruction.m_Operands         = operands.size();
+		operands.insert(operands.end(), begin, begin + instruction.m_InputCount + instruction.m_OutputCount);
+		instructions.push_back(instruction);
+	};
+	m_SerialOffsets.reserve(schedule.levelCount());
+	for (std::size_t level = 0; level < schedule.levelCount(); ++level)
+	{
+		for (std::size_t i = schedule.levelBegin(level); i < schedule.levelEnd(level); ++i)
+			if (!sharesOutput(m_Instructions[schedule[i]]))
+				append(schedule[i]);
+		m_SerialOffsets.push_back(instructions.size());
+		for (std::size_t i = schedule.levelBegin(level); i < schedule.levelEnd(level); ++i)
+			if (sharesOutput(m_Instructions[schedule[i]]))
+				append(schedule[i]);
+	}
+	for (std::size_t i = schedule.feedbackBegin(); i < schedule.feedbackEnd(); ++i)
+		append(schedule[i]);
+	m_Instructions = std::move(instructions);
+	m_Operands     = std::move(operands);
+	m_Schedule     = buildSchedule();
+}
+
+std::vector<BitSet> Netlist::computeSupport() const
+{
+	std::vector<BitSet> support(m_ConnectionCount, BitSet(m_Inputs.size()));
+	for (std::size_t i = 0; i < m_Inputs.size(); ++i)
+		if (m_Inputs[i] != c_SinkConnection)
+			support[m_Inputs[i]].set(i, true);
+
+	BitSet operands(m_Inputs.size());
+	auto   propagate = [&](const NetlistInstruction& instruction)
+	{
+		operands.fill(false);
+		for (std::size_t connection : getInputs(instruction))
+			operands |= support[connection];
+
+		bool changed = false;
+		for (std::size_t connection : getOutputs(instruction))
+		{
+			if (connection == c_SinkConnection)
+				continue;
+			BitSet merged  = support[connection];
+			merged        |= operands;
+			if (merged == support[connection])
+				continue;
+			support[connection] = std::move(merged);
+			changed             = true;
+		}
+		return changed;
+	};
+
+	for (std::size_t i = 0; i < m_Schedule.feedbackBegin(); ++i)
+		propagate(m_Instructions[i]);
+	// Feedback loops pass support around until nothing grows anymore
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (std::size_t i = m_Schedule.feedbackBegin(); i < m_Schedule.feedbackEnd(); ++i)
+			changed = propagate(m_Instructions[i]) || changed;
+	}
+
+	std::vector<BitSet> result;
+	result.reserve(m_Outputs.size());
+	for (std::size_t connection : m_Outputs)
+		result.push_back(support[connection]);
+	return result;
+}
+
+void Netlist::flatten(const Graph& graph, const std::vector<std::size_t>& connections)
+{
+	std::vector<std::size_t> inputs;
+	std::vector<std::size_t> outputs;
+	for (auto& node : graph.getNodes())
+	{
+		auto& component   = node->getComponent();
+		auto  inputPorts  = graph.getInputPorts(*node);
+		auto  outputPorts = graph.getOutputPorts(*node);
+
+		inputs.resize(inputPorts.size());
+		outputs.resize(outputPorts.size());
+		m_Revisions.addComponent(component);
+		for (std::size_t i = 0; i < inputPorts.size(); ++i)
+			inputs[i] = inputPorts[i] != ~0ULL ? connections[inputPorts[i]] : c_ZeroConnection;
+		for (std::size_t i = 0; i < outputPorts.size(); ++i)
+			outputs[i] = outputPorts[i] != ~0ULL ? connections[outputPorts[i]] : c_SinkConnection;
+
+		if (component->hasGate())
+		{
+			emit(component->getGate(), component->hasTruthTable() ? &component->getTruthTable() : nullptr, inputs, outputs);
+			continue;
+		}
+
+		if (component->hasTruthTable())
+		{
+			auto& truthTable = component->getTruthTable();
+			emit(ClassifyTruthTable(truthTable), &truthTable, inputs, outputs);
+			continue;
+		}
+
+		if (!component->hasGraph())
+		{
+			if (component->hasConeTable())
+				emitCones(component->getConeTable(), inputs, outputs);
+			else if (component->hasDecisionDiagram())
+				emitDiagram(component->getDecisionDiagram(), inputs, outputs);
+			continue;
+		}
+
+		auto& subGraph       = component->getGraph();
+		auto& subInputPorts  = subGraph.getInputPorts();
+		auto& subOutputPorts = subGraph.getOutputPorts();
+
+		// A nested input connection can only alias the parent connection when nothing else writes to it
+		std::vector<std::uint32_t> writes(subGraph.connectionCount(), 0);
+		for (auto& subNode : subGraph.getNodes())
+			for (std::size_t connection : subGraph.getOutputPorts(*subNode))
+				if (connection != ~0ULL)
+					++writes[connection];
+		for (std::size_t connection : subInputPorts)
+			if (connection != ~0ULL)
+				++writes[connection];
+
+		std::vector<std::size_t>                         subConnections(subGraph.connectionCount(), ~0ULL);
+		std::vector<std::size_t>                         aliased;
+		std::vector<std::pair<std::size_t, std::size_t>> copies;
+		auto                                             canAlias = [&](std::size_t connection)
+		{
+			return connection != c_ZeroConnection && connection != c_SinkConnection && std::find(aliased.begin(), aliased.end(), connection) == aliased.end();
+		};
+
+		for (std::size_t i = 0; i < subInputPorts.size(); ++i)
+		{
+			std::size_t connection = subInputPorts[i];
+			if (connection == ~0ULL)
+				continue;
+			if (writes[connection] == 1 && (inputs[i] == c_ZeroConnection || canAlias(inputs[i])))
+			{
+				subConnections[connection] = inputs[i];
+				aliased.push_back(inputs[i]);
+				continue;
+			}
+			if (subConnections[connection] == ~0ULL)
+				subConnections[connection] = m_ConnectionCount++;
+			std::size_t input = inputs[i];
+			emit(GateOp::Buffer, nullptr, { &input, 1 }, { &subConnections[connection], 1 });
+		}
+
+		for (std::size_t i = 0; i < subOutputPorts.size(); ++i)
+		{
+			std::size_t connection = subOutputPorts[i];
+			if (outputs[i] == c_SinkConnection)
+				continue;
+			if (connection == ~0ULL)
+			{
+				copies.emplace_back(~0ULL, outputs[i]);
+				continue;
+			}
+			if (subConnections[connection] == ~0ULL && canAlias(outputs[i]))
+			{
+				subConnections[connection] = outputs[i];
+				aliased.push_back(outputs[i]);
+				continue;
+			}
+			copies.emplace_back(connection, outputs[i]);
+		}
+
+		for (auto& connection : subConnections)
+			if (connection == ~0ULL)
+				connection = m_ConnectionCount++;
+
+		flatten(subGraph, subConnections);
+
+		for (auto& [from, to] : copies)
+		{
+			std::size_t input = from != ~0ULL ? subConnections[from] : c_ZeroConnection;
+			emit(GateOp::Buffer, nullptr, { &input, 1 }, { &to, 1 });
+		}
+	}
+}
+
+void Netlist::emit(GateOp op, const TruthTable* truthTable, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs)
+{
+	NetlistInstruction instruction {
+		op,
+		static_cast<std::uint32_t>(inputs.size()),
+		static_cast<std::uint32_t>(outputs.size()),
+		m_Operands.size(),
+		truthTable
+	};
+	m_Operands.insert(m_Operands.end(), inputs.begin(), inputs.end());
+	m_Operands.insert(m_Operands.end(), outputs.begin(), outputs.end());
+	m_Instructions.push_back(instruction);
+}
+
+void Netlist::emitCones(const ConeTable& cones, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs)
+{
+	std::vector<std::size_t> coneInputs;
+	std::vector<std::size_t> coneOutputs;
+	for (auto& cone : cones.getCones())
+	{
+		coneInputs.resize(cone.m_Inputs.size());
+		coneOutputs.resize(cone.m_Outputs.size());
+		for (std::size_t i = 0; i < cone.m_Inputs.size(); ++i)
+			coneInputs[i] = inputs[cone.m_Inputs[i]];
+		for (std::size_t i = 0; i < cone.m_Outputs.size(); ++i)
+			coneOutputs[i] = outputs[cone.m_Outputs[i]];
+		emit(ClassifyTruthTable(cone.m_TruthTable), &cone.m_TruthTable, coneInputs, coneOutputs);
+	}
+}
+
+void Netlist::emitDiagram(const DecisionDiagram& diagram, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs)
+{
+	auto& decisions = diagram.getNodes();
+	auto& order     = diagram.getOrder();
+
+	std::vector<std::size_t> nodes(decisions.size(), c_ZeroConnection);
+	std::vector<std::size_t> inverted(inputs.size(), ~0ULL);
+	auto                     newConnection = [this](GateOp op, std::size_t a, std::size_t b)
+	{
+		std::size_t operands[2] { a, b };
+		std::size_t connection = m_ConnectionCount++;
+		emit(op, nullptr, { operands, op == GateOp::Nor ? 1ULL : 2ULL }, { &connection, 1 });
+		return connection;
+	};
+	auto invert = [&](std::size_t input)
+	{
+		if (inverted[input] == ~0ULL)
+			inverted[input] = newConnection(GateOp::Nor, inputs[input], 0);
+		return inverted[input];
+	};
+	nodes[DecisionDiagram::c_True] = newConnection(GateOp::Nor, c_ZeroConnection, 0);
+
+	// Children always come before their parent, so a single pass sees every operand already emitted
+	for (std::size_t i = 2; i < decisions.size(); ++i)
+	{
+		auto&       decision = decisions[i];
+		std::size_t input    = order[decision.m_Level];
+		if (decision.m_Low == DecisionDiagram::c_False && decision.m_High == DecisionDiagram::c_True)
+			nodes[i] = inputs[input];
+		else if (decision.m_Low == DecisionDiagram::c_True && decision.m_High == DecisionDiagram::c_False)
+			nodes[i] = invert(input);
+		else if (decision.m_Low == DecisionDiagram::c_False)
+			nodes[i] = newConnection(GateOp::And, inputs[input], nodes[decision.m_High]);
+		else if (decision.m_High == DecisionDiagram::c_False)
+			nodes[i] = newConnection(GateOp::And, invert(input), nodes[decision.m_Low]);
+		else
+			nodes[i] = newConnection(GateOp::Or, newConnection(GateOp::And, inputs[input], nodes[decision.m_High]), newConnection(GateOp::And, invert(input), nodes[decision.m_Low]));
+	}
+
+	auto& roots = diagram.getRoots();
+	for (std::size_t i = 0; i < outputs.size(); ++i)
+		if (outputs[i] != c_SinkConnection)
+			emit(GateOp::Buffer, nullptr, { &nodes[roots[i]], 1 }, { &outputs[i], 1 });
+}
\ No newline at end of file
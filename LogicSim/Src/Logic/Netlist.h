@@ -0,0 +1,95 @@
+#pragma once
+
+#include "ConeTable.h"
+#include "DecisionDiagram.h"
+#include "Gate.h"
+#include "Graph.h"
+#include "RevisionSet.h"
+#include "Schedule.h"
+#include "TruthTable.h"
+
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+struct NetlistInstruction
+{
+public:
+	GateOp            m_Op;
+	std::uint32_t     m_InputCount;
+	std::uint32_t     m_OutputCount;
+	std::size_t       m_Operands; // Offset of the first input connection, the output connections follow the inputs
+	const TruthTable* m_TruthTable;
+};
+
+// Graph hierarchy flattened into a single levelized array of primitive instructions over a dense connection index space.
+// Nested graphs are inlined, their input and output connections alias the connections of the parent graph wherever possible.
+// Components that only carry a ConeTable become one table instruction per cone, components that only carry a DecisionDiagram are expanded into one and/or multiplexer per decision node.
+// Unconnected inputs read from ZeroConnection and unconnected outputs write to SinkConnection, so every operand is a valid index.
+struct Netlist
+{
+public:
+	static constexpr std::size_t c_ZeroConnection = 0;
+	static constexpr std::size_t c_SinkConnection = 1;
+
+	// Recognizes single output truth tables that are and/or/xor family gates, returns GateOp::Table otherwise
+	static GateOp ClassifyTruthTable(const TruthTable& truthTable);
+
+public:
+	Netlist(const Graph& graph);
+
+	std::size_t inputCount() const { return m_Inputs.size(); }
+	std::size_t outputCount() const { return m_Outputs.size(); }
+	std::size_t connectionCount() const { return m_ConnectionCount; }
+	std::size_t instructionCount() const { return m_Instructions.size(); }
+
+	auto& getInstructions() const { return m_Instructions; }
+	auto& getOperands() const { return m_Operands; }
+	auto& getInputs() const { return m_Inputs; }
+	auto& getOutputs() const { return m_Outputs; }
+	auto& getSchedule() const { return m_Schedule; }
+	// Instructions of `level` from here on write a connection that another instruction writes as well, so they can't run concurrently
+	std::size_t serialBegin(std::size_t level) const { return m_SerialOffsets[level]; }
+
+	// True once a flattened graph was edited or a flattened component was removed or changed its representations, the table instructions may point at freed tables then.
+	// Every state built over an outdated netlist has to be rebuilt along with it, the graph the netlist was built from has to outlive it
+	bool outdated() const { return m_Revisions.outdated(); }
+
+	// Inputs every output transitively depends on, as one bit per netlist input
+	std::vector<BitSet> computeSupport() const;
+
+	std::span<const std::size_t> getInputs(const NetlistInstruction& instruction) const { return { m_Operands.data() + instruction.m_Operands, instruction.m_InputCount }; }
+	std::span<const std::size_t> getOutputs(const NetlistInstruction& instruction) const { return { m_Operands.data() + instruction.m_Operands + instruction.m_InputCount, instruction.m_OutputCount }; }
+
+	std::size_t allocatedSizeOf() const
+	{
+		return m_Instructions.capacity() * sizeof(NetlistInstruction) + (m_Operands.capacity() + m_Inputs.capacity() + m_Outputs.capacity() + m_SerialOffsets.capacity()) * sizeof(std::size_t) + m_Schedule.allocatedSizeOf() + m_Revisions.allocatedSizeOf();
+	}
+
+	std::size_t totalSizeOf() const
+	{
+		return sizeof(*this) + allocatedSizeOf();
+	}
+
+private:
+	void flatten(const Graph& graph, const std::vector<std::size_t>& connections);
+
+	void emit(GateOp op, const TruthTable* truthTable, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs);
+	void emitCones(const ConeTable& cones, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs);
+	void emitDiagram(const DecisionDiagram& diagram, std::span<const std::size_t> inputs, std::span<const std::size_t> outputs);
+
+private:
+	std::vector<NetlistInstruction> m_Instructions;
+	std::vector<std::size_t>        m_Operands;
+	std::vector<std::size_t>        m_Inputs;
+	std::vector<std::size_t>        m_Outputs;
+	std::size_t                     m_ConnectionCount;
+
+	// Levelized order of the instructions, instruction i is at schedule index i
+	Schedule                 m_Schedule;
+	std::vector<std::size_t> m_SerialOffsets;
+
+	// Revisions and versions everything was flattened from, see outdated()
+	RevisionSet m_Revisions;
+};
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "PatternKernels.h"
+#include "Utils/CPU.h"
+#include "Utils/Core.h"
+
+#if BUILD_IS_PLATFORM_AMD64
+#include <immintrin.h>
+
+#if BUILD_IS_TOOLSET_MSVC
+#define PATTERN_TARGET(isa)
+#else
+#define PATTERN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using Word = PatternKernels::Word;
+
+//--------
+// Scalar
+//--------
+
+static void AndScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t begin, std::size_t end, bool invert)
+{
+	Word mask = invert ? ~Word { 0 } : Word { 0 };
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		Word value = ~Word { 0 };
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value &= inputs[j][i];
+		out[i] = value ^ mask;
+	}
+}
+
+static void OrScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t begin, std::size_t end, bool invert)
+{
+	Word mask = invert ? ~Word { 0 } : Word { 0 };
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		Word value = 0;
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value |= inputs[j][i];
+		out[i] = value ^ mask;
+	}
+}
+
+static void XorScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t begin, std::size_t end, bool invert)
+{
+	Word mask = invert ? ~Word { 0 } : Word { 0 };
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		// Track lanes that have seen at least one and at least two high inputs
+		Word one  = 0;
+		Word many = 0;
+		for (std::size_t j = 0; j < inputCount; ++j)
+		{
+			many |= one & inputs[j][i];
+			one |= inputs[j][i];
+		}
+		out[i] = (one & ~many) ^ mask;
+	}
+}
+
+static void MuxScalar(Word* out, const Word* low, const Word* high, const Word* select, std::size_t begin, std::size_t end)
+{
+	for (std::size_t i = begin; i < end; ++i)
+		out[i] = low[i] ^ ((low[i] ^ high[i]) & select[i]);
+}
+
+static void AndScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert) { AndScalar(out, inputs, inputCount, 0, words, invert); }
+static void OrScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert) { OrScalar(out, inputs, inputCount, 0, words, invert); }
+static void XorScalar(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert) { XorScalar(out, inputs, inputCount, 0, words, invert); }
+static void MuxScalar(Word* out, const Word* low, const Word* high, const Word* select, std::size_t words) { MuxScalar(out, low, high, select, 0, words); }
+
+#if BUILD_IS_PLATFORM_AMD64
+
+//------
+// AVX2
+//------
+
+PATTERN_TARGET("avx2")
+static void AndAVX2(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m256i     ones = _mm256_set1_epi64x(-1);
+	__m256i     mask = invert ? ones : _mm256_setzero_si256();
+	std::size_t i    = 0;
+	for (; i + 4 <= words; i += 4)
+	{
+		__m256i value = ones;
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value = _mm256_and_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs[j] + i)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(value, mask));
+	}
+	AndScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx2")
+static void OrAVX2(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m256i     mask = invert ? _mm256_set1_epi64x(-1) : _mm256_setzero_si256();
+	std::size_t i    = 0;
+	for (; i + 4 <= words; i += 4)
+	{
+		__m256i value = _mm256_setzero_si256();
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value = _mm256_or_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs[j] + i)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(value, mask));
+	}
+	OrScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx2")
+static void XorAVX2(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m256i     mask = invert ? _mm256_set1_epi64x(-1) : _mm256_setzero_si256();
+	std::size_t i    = 0;
+	for (; i + 4 <= words; i += 4)
+	{
+		__m256i one  = _mm256_setzero_si256();
+		__m256i many = _mm256_setzero_si256();
+		for (std::size_t j = 0; j < inputCount; ++j)
+		{
+			__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs[j] + i));
+			many          = _mm256_or_si256(many, _mm256_and_si256(one, input));
+			one           = _mm256_or_si256(one, input);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(_mm256_andnot_si256(many, one), mask));
+	}
+	XorScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx2")
+static void MuxAVX2(Word* out, const Word* low, const Word* high, const Word* select, std::size_t words)
+{
+	std::size_t i = 0;
+	for (; i + 4 <= words; i += 4)
+	{
+		__m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low + i));
+		__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high + i));
+		__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(select + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(l, _mm256_and_si256(_mm256_xor_si256(l, h), s)));
+	}
+	MuxScalar(out, low, high, select, i, words);
+}
+
+//---------
+// AVX-512
+//---------
+
+PATTERN_TARGET("avx512f")
+static void AndAVX512(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m512i     ones = _mm512_set1_epi64(-1);
+	__m512i     mask = invert ? ones : _mm512_setzero_si512();
+	std::size_t i    = 0;
+	for (; i + 8 <= words; i += 8)
+	{
+		__m512i value = ones;
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value = _mm512_and_si512(value, _mm512_loadu_si512(inputs[j] + i));
+		_mm512_storeu_si512(out + i, _mm512_xor_si512(value, mask));
+	}
+	AndScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx512f")
+static void OrAVX512(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m512i     mask = invert ? _mm512_set1_epi64(-1) : _mm512_setzero_si512();
+	std::size_t i    = 0;
+	for (; i + 8 <= words; i += 8)
+	{
+		__m512i value = _mm512_setzero_si512();
+		for (std::size_t j = 0; j < inputCount; ++j)
+			value = _mm512_or_si512(value, _mm512_loadu_si512(inputs[j] + i));
+		_mm512_storeu_si512(out + i, _mm512_xor_si512(value, mask));
+	}
+	OrScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx512f")
+static void XorAVX512(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert)
+{
+	__m512i     mask = invert ? _mm512_set1_epi64(-1) : _mm512_setzero_si512();
+	std::size_t i    = 0;
+	for (; i + 8 <= words; i += 8)
+	{
+		__m512i one  = _mm512_setzero_si512();
+		__m512i many = _mm512_setzero_si512();
+		for (std::size_t j = 0; j < inputCount; ++j)
+		{
+			__m512i input = _mm512_loadu_si512(inputs[j] + i);
+			many          = _mm512_or_si512(many, _mm512_and_si512(one, input));
+			one           = _mm512_or_si512(one, input);
+		}
+		// 0x9A: (one & ~many) ^ mask, _mm512_andnot_si512 passes an undefined source that GCC reports as maybe uninitialized
+		_mm512_storeu_si512(out + i, _mm512_ternarylogic_epi64(one, many, mask, 0x9A));
+	}
+	XorScalar(out, inputs, inputCount, i, words, invert);
+}
+
+PATTERN_TARGET("avx512f")
+static void MuxAVX512(Word* out, const Word* low, const Word* high, const Word* select, std::size_t words)
+{
+	std::size_t i = 0;
+	for (; i + 8 <= words; i += 8)
+	{
+		__m512i l = _mm512_loadu_si512(low + i);
+		__m512i h = _mm512_loadu_si512(high + i);
+		__m512i s = _mm512_loadu_si512(select + i);
+		// 0xCA: select ? high : low
+		_mm512_storeu_si512(out + i, _mm512_ternarylogic_epi64(s, h, l, 0xCA));
+	}
+	MuxScalar(out, low, high, select, i, words);
+}
+
+#endif
+
+const PatternKernels& PatternKernels::Scalar()
+{
+	static constexpr PatternKernels s_Scalar { "Scalar", 1, &AndScalar, &OrScalar, &XorScalar, &MuxScalar };
+	return s_Scalar;
+}
+
+const PatternKernels& PatternKernels::Get()
+{
+#if BUILD_IS_PLATFORM_AMD64
+	static constexpr PatternKernels s_AVX2 { "AVX2", 4, &AndAVX2, &OrAVX2, &XorAVX2, &MuxAVX2 };
+	static constexpr PatternKernels s_AVX512 { "AVX-512", 8, &AndAVX512, &OrAVX512, &XorAVX512, &MuxAVX512 };
+
+	if (CPU::HasAVX512())
+		return s_AVX512;
+	if (CPU::HasAVX2())
+		return s_AVX2;
+	return Scalar();
+#else
+	return Scalar();
+#endif
+}
\ No newline at end of file
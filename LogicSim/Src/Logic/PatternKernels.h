@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Word wide evaluation kernels used by PatternState.
+// Get() picks the widest instruction set supported by the host at runtime and falls back to plain 64 bit operations.
+struct PatternKernels
+{
+public:
+	using Word = std::uint64_t;
+
+	// out[i] = op(inputs[0][i], ..., inputs[inputCount - 1][i]) for every i < words, inverted when `invert` is set
+	using GateFunction = void (*)(Word* out, const Word* const* inputs, std::size_t inputCount, std::size_t words, bool invert);
+	// out[i] = select[i] ? high[i] : low[i] bitwise for every i < words, `out` may alias `low`
+	using MuxFunction = void (*)(Word* out, const Word* low, const Word* high, const Word* select, std::size_t words);
+
+	static const PatternKernels& Get();
+	static const PatternKernels& Scalar();
+
+public:
+	const char*  m_Name;
+	std::size_t  m_Words; // Words processed per instruction
+	GateFunction m_And;
+	GateFunction m_Or;
+	GateFunction m_Xor; // High when exactly one input is high
+	MuxFunction  m_Mux;
+};
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "PatternState.h"
+#include "Utils/Log.h"
+
+#include <algorithm>
+#include <bit>
+
+PatternState::Word PatternState::EnumerationPattern(std::size_t input, std::uint64_t base)
+{
+	static constexpr Word c_LanePatterns[6] {
+		0xAAAA'AAAA'AAAA'AAAAULL,
+		0xCCCC'CCCC'CCCC'CCCCULL,
+		0xF0F0'F0F0'F0F0'F0F0ULL,
+		0xFF00'FF00'FF00'FF00ULL,
+		0xFFFF'0000'FFFF'0000ULL,
+		0xFFFF'FFFF'0000'0000ULL
+	};
+
+	if (input < 6)
+		return c_LanePatterns[input];
+	return (base >> input) & 1 ? ~Word { 0 } : Word { 0 };
+}
+
+PatternState::PatternState(const Netlist& netlist, std::size_t words)
+    : m_Netlist(netlist),
+      m_Kernels(&PatternKernels::Get()),
+      m_Words(std::max<std::size_t>(words, 1)),
+      m_Connections(netlist.connectionCount() * m_Words, 0),
+      m_Inputs(netlist.inputCount() * m_Words, 0),
+      m_Outputs(netlist.outputCount() * m_Words, 0),
+      m_TableRows(0),
+      m_MaxInputs(0)
+{
+	std::size_t maxTable = 0;
+	for (auto& instruction : m_Netlist.getInstructions())
+	{
+		m_MaxInputs = std::max<std::size_t>(m_MaxInputs, instruction.m_InputCount);
+		if (instruction.m_Op == GateOp::Table)
+			maxTable = std::max<std::size_t>(maxTable, instruction.m_InputCount);
+	}
+	m_TableRows = 1ULL << maxTable;
+}
+
+bool PatternState::refuseOutdated() const
+{
+	if (!m_Netlist.outdated())
+		return false;
+	Log::Warn("Refusing to tick a PatternState over an outdated netlist, rebuild both first");
+	return true;
+}
+
+PatternState::Scratch PatternState::newScratch() const
+{
+	Scratch scratch;
+	scratch.m_Table.resize(m_TableRows * m_Words);
+	scratch.m_InputBlocks.resize(m_MaxInputs);
+	return scratch;
+}
+
+void PatternState::tick()
+{
+	if (refuseOutdated())
+		return;
+
+	resizeScratch(1);
+	loadInputs();
+	evaluateRange(0, m_Netlist.instructionCount(), m_Scratch[0]);
+	storeOutputs();
+}
+
+void PatternState::tick(Scratch& scratch)
+{
+	if (refuseOutdated())
+		return;
+
+	loadInputs();
+	evaluateRange(0, m_Netlist.instructionCount(), scratch);
+	storeOutputs();
+}
+
+void PatternState::tick(ThreadPool& pool)
+{
+	if (refuseOutdated())
+		return;
+
+	resizeScratch(pool.workerCount());
+	loadInputs();
+
+	auto& schedule = m_Netlist.getSchedule();
+	for (std::size_t level = 0; level < schedule.levelCount(); ++level)
+	{
+		std::size_t begin  = schedule.levelBegin(level);
+		std::size_t serial = m_Netlist.serialBegin(level);
+		std::size_t end    = schedule.levelEnd(level);
+		if (serial - begin < c_ParallelGrain * 2)
+		{
+			evaluateRange(begin, end, m_Scratch[0]);
+			continue;
+		}
+
+		std::size_t workers       = std::min(pool.workerCount(), (serial - begin) / c_ParallelGrain);
+		auto        evaluateChunk = [this, begin, serial, workers](std::size_t first, std::size_t last, std::size_t worker)
+		{
+			std::size_t count = serial - begin;
+			evaluateRange(begin + count * first / workers, begin + count * last / workers, m_Scratch[worker]);
+		};
+		pool.parallelFor(workers, evaluateChunk);
+		// Instructions sharing an output connection keep their serial order, so the same writer wins as in tick()
+		evaluateRange(serial, end, m_Scratch[0]);
+	}
+	// Feedback instructions depend on each other in evaluation order and stay on the calling thread
+	evaluateRange(schedule.feedbackBegin(), schedule.feedbackEnd(), m_Scratch[0]);
+
+	storeOutputs();
+}
+
+void PatternState::resizeScratch(std::size_t workers)
+{
+	if (m_Scratch.size() >= workers)
+		return;
+
+	m_Scratch.reserve(workers);
+	while (m_Scratch.size() < workers)
+		m_Scratch.push_back(newScratch());
+}
+
+void PatternState::loadInputs()
+{
+	auto& inputs = m_Netlist.getInputs();
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		std::copy_n(&m_Inputs[i * m_Words], m_Words, writeBlock(inputs[i]));
+}
+
+void PatternState::storeOutputs()
+{
+	auto& outputs = m_Netlist.getOutputs();
+	for (std::size_t i = 0; i < outputs.size(); ++i)
+		std::copy_n(readBlock(outputs[i]), m_Words, &m_Outputs[i * m_Words]);
+}
+
+void PatternState::evaluateRange(std::size_t begin, std::size_t end, Scratch& scratch)
+{
+	auto& instructions = m_Netlist.getInstructions();
+	for (std::size_t i = begin; i < end; ++i)
+		evaluate(instructions[i], scratch);
+}
+
+void PatternState::evaluate(const NetlistInstruction& instruction, Scratch& scratch)
+{
+	if (instruction.m_Op == GateOp::Table)
+	{
+		evaluateTable(instruction, scratch);
+		return;
+	}
+
+	// Writes to the sink are dropped, every other connection written by more than one instruction is only written from the serial tail of a level
+	std::size_t output = m_Netlist.getOutputs(instruction)[0];
+	if (output == Netlist::c_SinkConnection)
+		return;
+
+	auto         inputs      = m_Netlist.getInputs(instruction);
+	const Word** inputBlocks = scratch.m_InputBlocks.data();
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+		inputBlocks[i] = readBlock(inputs[i]);
+
+	Word* out = writeBlock(output);
+	switch (instruction.m_Op)
+	{
+	case GateOp::Buffer:
+	case GateOp::And: m_Kernels->m_And(out, inputBlocks, inputs.size(), m_Words, false); break;
+	case GateOp::Nand: m_Kernels->m_And(out, inputBlocks, inputs.size(), m_Words, true); break;
+	case GateOp::Or: m_Kernels->m_Or(out, inputBlocks, inputs.size(), m_Words, false); break;
+	case GateOp::Nor: m_Kernels->m_Or(out, inputBlocks, inputs.size(), m_Words, true); break;
+	case GateOp::Xor: m_Kernels->m_Xor(out, inputBlocks, inputs.size(), m_Words, false); break;
+	case GateOp::Xnor: m_Kernels->m_Xor(out, inputBlocks, inputs.size(), m_Words, true); break;
+	default: break;
+	}
+}
+
+void PatternState::evaluateTable(const NetlistInstruction& instruction, Scratch& scratch)
+{
+	auto& truthTable = *instruction.m_TruthTable;
+	auto  inputs     = m_Netlist.getInputs(instruction);
+	auto  outputs    = m_Netlist.getOutputs(instruction);
+	Word* table      = scratch.m_Table.data();
+
+	std::size_t rows = 1ULL << inputs.size();
+	for (std::size_t output = 0; output < outputs.size(); ++output)
+	{
+		if (outputs[output] == Netlist::c_SinkConnection)
+			continue;
+
+		// Mux tree over the output column, every level selects between row pairs using the next input
+		for (std::size_t row = 0; row < rows; ++row)
+			std::fill_n(&table[row * m_Words], m_Words, truthTable.getOutput(static_cast<std::uint16_t>(row), output) ? ~Word { 0 } : Word { 0 });
+		for (std::size_t i = 0, count = rows; i < inputs.size(); ++i, count >>= 1)
+		{
+			const Word* select = readBlock(inputs[i]);
+			for (std::size_t row = 0; row < count; row += 2)
+				m_Kernels->m_Mux(&table[(row >> 1) * m_Words], &table[row * m_Words], &table[(row + 1) * m_Words], select, m_Words);
+		}
+		std::copy_n(&table[0], m_Words, writeBlock(outputs[output]));
+	}
+}
\ No newline at end of file
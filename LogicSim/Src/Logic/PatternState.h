@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Netlist.h"
+#include "PatternKernels.h"
+#include "Utils/ThreadPool.h"
+
+#include <cstdint>
+
+#include <vector>
+
+// Bit parallel counterpart of GraphState, evaluating a flattened Netlist.
+// Every connection is a block of 64 bit words where each bit belongs to an independent input pattern, so one tick evaluates 64 input vectors per word.
+// Gates are evaluated through PatternKernels, so blocks of 4 or 8 words map onto AVX2 or AVX-512 registers when the host supports them.
+// Instructions within a level never read each others outputs and those writing a connection another instruction writes as well sit at the end of the level,
+// so the rest of a level can be split across threads without synchronizing connection writes.
+struct PatternState
+{
+public:
+	using Word = PatternKernels::Word;
+
+	static constexpr std::size_t c_WordLanes = 64;
+	// Levels with fewer instructions per worker are evaluated on the calling thread, the barrier would cost more than the level
+	static constexpr std::size_t c_ParallelGrain = 64;
+
+	// Word count that fills one register of the widest instruction set supported by the host
+	static std::size_t PreferredWordCount() { return PatternKernels::Get().m_Words; }
+
+	// Pattern for input `input` such that lane i of the block starting at `base` holds the input combination `base + i`
+	static Word EnumerationPattern(std::size_t input, std::uint64_t base);
+
+	// Per worker buffers for the table mux tree and gate input pointers, sized by the widest table and gate of a netlist.
+	// Instances of the same netlist and word count can share one per thread, see BatchSimulation
+	struct Scratch
+	{
+	public:
+		std::vector<Word>        m_Table;
+		std::vector<const Word*> m_InputBlocks;
+
+		std::size_t allocatedSizeOf() const { return m_Table.capacity() * sizeof(Word) + m_InputBlocks.capacity() * sizeof(const Word*); }
+	};
+
+public:
+	// Scratch is only allocated on the first tick without an explicit Scratch, so instances ticked with shared scratch only own their connection words
+	PatternState(const Netlist& netlist, std::size_t words = PreferredWordCount());
+	PatternState(PatternState&& move) noexcept
+	    : m_Netlist(move.m_Netlist),
+	      m_Kernels(move.m_Kernels),
+	      m_Words(move.m_Words),
+	      m_Connections(std::move(move.m_Connections)),
+	      m_Inputs(std::move(move.m_Inputs)),
+	      m_Outputs(std::move(move.m_Outputs)),
+	      m_TableRows(move.m_TableRows),
+	      m_MaxInputs(move.m_MaxInputs),
+	      m_Scratch(std::move(move.m_Scratch)) {}
+
+	void setInput(std::size_t input, std::size_t word, Word patterns) { m_Inputs[input * m_Words + word] = patterns; }
+	Word getOutput(std::size_t output, std::size_t word) const { return m_Outputs[output * m_Words + word]; }
+
+	// Does nothing but warn when the netlist is outdated(), its table instructions may point at freed tables
+	void tick();
+	// Same as tick() but evaluates with caller owned buffers from newScratch()
+	void tick(Scratch& scratch);
+	// Same as tick() but evaluates wide levels in parallel on `pool`, a barrier separates consecutive levels
+	void tick(ThreadPool& pool);
+
+	std::size_t inputCount() const { return m_Netlist.inputCount(); }
+	std::size_t outputCount() const { return m_Netlist.outputCount(); }
+	std::size_t wordCount() const { return m_Words; }
+	std::size_t laneCount() const { return m_Words * c_WordLanes; }
+
+	Scratch newScratch() const;
+
+	auto& getNetlist() const { return m_Netlist; }
+
+	std::size_t allocatedSizeOf() const
+	{
+		std::size_t size = (m_Connections.capacity() + m_Inputs.capacity() + m_Outputs.capacity()) * sizeof(Word) + m_Scratch.capacity() * sizeof(Scratch);
+		for (auto& scratch : m_Scratch)
+			size += scratch.allocatedSizeOf();
+		return size;
+	}
+
+	std::size_t totalSizeOf() const
+	{
+		return sizeof(*this) + allocatedSizeOf();
+	}
+
+private:
+	const Word* readBlock(std::size_t connection) const { return &m_Connections[connection * m_Words]; }
+	Word*       writeBlock(std::size_t connection) { return &m_Connections[connection * m_Words]; }
+
+	// Warns and returns true when the netlist is outdated(), checking is only a revision compare unless something was edited since
+	bool refuseOutdated() const;
+	void resizeScratch(std::size_t workers);
+	void loadInputs();
+	void storeOutputs();
+
+	void evaluateRange(std::size_t begin, std::size_t end, Scratch& scratch);
+	void evaluate(const NetlistInstruction& instruction, Scratch& scratch);
+	void evaluateTable(const NetlistInstruction& instruction, Scratch& scratch);
+
+private:
+	const Netlist&        m_Netlist;
+	const PatternKernels* m_Kernels;
+	std::size_t           m_Words;
+
+	std::vector<Word> m_Connections;
+	std::vector<Word> m_Inputs;
+	std::vector<Word> m_Outputs;
+
+	std::size_t          m_TableRows;
+	std::size_t          m_MaxInputs;
+	std::vector<Scratch> m_Scratch;
+};
\ No newline at end of file
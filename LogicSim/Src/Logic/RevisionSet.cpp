@@ -0,0 +1,67 @@
+#include "RevisionSet.h"
+#include "Component.h"
+
+#include <algorithm>
+#include <tuple>
+
+static std::atomic<std::uint64_t> s_Revision { 0 };
+
+std::uint64_t RevisionSet::NextRevision()
+{
+	return ++s_Revision;
+}
+
+std::uint64_t RevisionSet::CurrentRevision()
+{
+	return s_Revision.load();
+}
+
+void RevisionSet::addGraph(const Graph& graph)
+{
+	m_Graphs.emplace_back(&graph, graph.revision());
+}
+
+void RevisionSet::addComponent(ResourceManager::Ref<Component> component)
+{
+	m_Components.push_back({ component, component->version(), component->hasGraph() ? component->getGraph().revision() : 0 });
+}
+
+void RevisionSet::merge(RevisionSet&& other)
+{
+	m_Components.insert(m_Components.end(), other.m_Components.begin(), other.m_Components.end());
+	other.m_Graphs.clear();
+	other.m_Components.clear();
+}
+
+void RevisionSet::compact()
+{
+	auto key = [](const ComponentRevision& revision) { return std::tuple { revision.m_Component.pool(), revision.m_Component.index(), revision.m_Version, revision.m_GraphRevision }; };
+
+	std::sort(m_Graphs.begin(), m_Graphs.end());
+	m_Graphs.erase(std::unique(m_Graphs.begin(), m_Graphs.end()), m_Graphs.end());
+	std::sort(m_Components.begin(), m_Components.end(), [&](const ComponentRevision& lhs, const ComponentRevision& rhs) { return key(lhs) < key(rhs); });
+	m_Components.erase(std::unique(m_Components.begin(), m_Components.end(), [&](const ComponentRevision& lhs, const ComponentRevision& rhs) { return key(lhs) == key(rhs); }), m_Components.end());
+}
+
+bool RevisionSet::outdated() const
+{
+	// Read before comparing, an edit racing the comparison moves the revision past what gets recorded
+	std::uint64_t current = CurrentRevision();
+	if (m_CheckedRevision.load(std::memory_order_relaxed) == current)
+		return false;
+
+	for (auto& [graph, revision] : m_Graphs)
+		if (graph->revision() != revision)
+			return true;
+	for (auto& revision : m_Components)
+	{
+		const Component* component = revision.m_Component.get();
+		if (!component || component->version() != revision.m_Version)
+			return true;
+		if ((component->hasGraph() ? component->getGraph().revision() : 0) != revision.m_GraphRevision)
+			return true;
+	}
+
+	m_CheckedRevision.store(current, std::memory_order_relaxed);
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ResourceManager/ResourceManager.h"
+
+#include <cstdint>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+struct Component;
+struct Graph;
+
+// Graph revisions and component versions a Netlist or GraphState was built from.
+// Components are held by ref, a removed component resolves to nothing instead of freed memory and counts as outdated, nested graphs are reached through their components.
+// Graph revisions, component versions and component removals all advance one global edit revision, outdated() only compares entries again once it moved since the last check that passed
+struct RevisionSet
+{
+public:
+	// Unique across all graphs and components, see Graph::revision() and Component::version()
+	static std::uint64_t NextRevision();
+	static std::uint64_t CurrentRevision();
+
+public:
+	RevisionSet() : m_CheckedRevision(CurrentRevision()) {}
+	RevisionSet(RevisionSet&& move) noexcept
+	    : m_Graphs(std::move(move.m_Graphs)),
+	      m_Components(std::move(move.m_Components)),
+	      m_CheckedRevision(move.m_CheckedRevision.load(std::memory_order_relaxed)) {}
+	RevisionSet& operator=(RevisionSet&& move) noexcept
+	{
+		m_Graphs     = std::move(move.m_Graphs);
+		m_Components = std::move(move.m_Components);
+		m_CheckedRevision.store(move.m_CheckedRevision.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		return *this;
+	}
+
+	// `graph` is not owned by a component the set knows about, so it has to outlive the set
+	void addGraph(const Graph& graph);
+	void addComponent(ResourceManager::Ref<Component> component);
+	// Takes over the component entries of `other`, which is left empty. Its graphs have to belong to components of this set, they are covered by those
+	void merge(RevisionSet&& other);
+	// Drops repeated entries, components are usually instantiated many times
+	void compact();
+
+	// True once a graph was edited, or a component was removed, changed its representations or had its graph edited
+	bool outdated() const;
+
+	std::size_t allocatedSizeOf() const { return m_Graphs.capacity() * sizeof(std::pair<const Graph*, std::uint64_t>) + m_Components.capacity() * sizeof(ComponentRevision); }
+
+private:
+	struct ComponentRevision
+	{
+	public:
+		ResourceManager::Ref<Component> m_Component;
+		std::uint64_t                   m_Version;
+		std::uint64_t                   m_GraphRevision; // 0 without a graph
+	};
+
+private:
+	std::vector<std::pair<const Graph*, std::uint64_t>> m_Graphs;
+	std::vector<ComponentRevision>                      m_Components;
+
+	mutable std::atomic<std::uint64_t> m_CheckedRevision;
+};
\ No newline at end of file
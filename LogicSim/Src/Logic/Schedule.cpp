@@ -0,0 +1,10 @@
+#include "Schedule.h"
+#include "Graph.h"
+
+Schedule::Schedule(const Graph& graph)
+    : Schedule(
+          graph.getNodes().resources().size(), graph.connectionCount(),
+          [&graph](std::size_t i) { return graph.getInputPorts(*graph.getNodes().resources()[i]); },
+          [&graph](std::size_t i) { return graph.getOutputPorts(*graph.getNodes().resources()[i]); })
+{
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+struct Graph;
+
+// Static evaluation order for the nodes of a Graph, or any other list of nodes reading and writing connections.
+// Nodes are stored as positions into Graph::getNodes(), grouped into levels where every node only depends on nodes in earlier levels.
+// Nodes that are part of, or driven by, a feedback loop can't be levelized and are placed after the last level,
+// grouped into strongly connected components in topological order, where every cyclic component is a loop that has to be iterated to settle.
+// The schedule also keeps a fanout index mapping every connection to the schedule indices of the nodes reading it.
+struct Schedule
+{
+public:
+	Schedule() : m_FeedbackOffset(0), m_ComponentOffsets({ 0 }) {}
+	Schedule(const Graph& graph);
+	// Generic form, `inputsOf(i)` and `outputsOf(i)` return ranges of the connections read and written by node i, ~0ULL marks an unconnected port
+	template <class InputsF, class OutputsF>
+	Schedule(std::size_t nodeCount, std::size_t connectionCount, InputsF&& inputsOf, OutputsF&& outputsOf);
+
+	std::size_t levelCount() const { return m_LevelOffsets.empty() ? 0 : m_LevelOffsets.size() - 1; }
+	std::size_t levelBegin(std::size_t level) const { return m_LevelOffsets[level]; }
+	std::size_t levelEnd(std::size_t level) const { return m_LevelOffsets[level + 1]; }
+	std::size_t feedbackBegin() const { return m_FeedbackOffset; }
+	std::size_t feedbackEnd() const { return m_Order.size(); }
+	bool        hasFeedback() const { return m_FeedbackOffset != m_Order.size(); }
+
+	// Strongly connected components of the feedback nodes, `cyclic` is false for single nodes that are only driven by a loop
+	std::size_t componentCount() const { return m_CyclicComponents.size(); }
+	std::size_t componentBegin(std::size_t component) const { return m_ComponentOffsets[component]; }
+	std::size_t componentEnd(std::size_t component) const { return m_ComponentOffsets[component + 1]; }
+	bool        isCyclic(std::size_t component) const { return m_CyclicComponents[component]; }
+
+	std::size_t size() const { return m_Order.size(); }
+	auto&       getOrder() const { return m_Order; }
+
+	std::size_t operator[](std::size_t i) const { return m_Order[i]; }
+
+	std::size_t fanoutBegin(std::size_t connection) const { return m_FanoutOffsets[connection]; }
+	std::size_t fanoutEnd(std::size_t connection) const { return m_FanoutOffsets[connection + 1]; }
+	std::size_t fanout(std::size_t i) const { return m_Fanout[i]; }
+
+	auto begin() const { return m_Order.begin(); }
+	auto end() const { return m_Order.end(); }
+
+	std::size_t allocatedSizeOf() const
+	{
+		return (m_Order.capacity() + m_LevelOffsets.capacity() + m_ComponentOffsets.capacity() + m_FanoutOffsets.capacity() + m_Fanout.capacity()) * sizeof(std::size_t) + m_CyclicComponents.capacity() / 8;
+	}
+
+	std::size_t totalSizeOf() const
+	{
+		return sizeof(*this) + allocatedSizeOf();
+	}
+
+private:
+	std::vector<std::size_t> m_Order;
+	std::vector<std::size_t> m_LevelOffsets;
+	std::size_t              m_FeedbackOffset;
+	std::vector<std::size_t> m_ComponentOffsets;
+	std::vector<bool>        m_CyclicComponents;
+
+	std::vector<std::size_t> m_FanoutOffsets;
+	std::vector<std::size_t> m_Fanout;
+};
+
+//----------------
+// Implementation
+//----------------
+
+template <class InputsF, class OutputsF>
+Schedule::Schedule(std::size_t nodeCount, std::size_t connectionCount, InputsF&& inputsOf, OutputsF&& outputsOf)
+    : m_FeedbackOffset(0)
+{
+	// Build the driver list of every connection
+	std::vector<std::size_t> driverOffsets(connectionCount + 1, 0);
+	for (std::size_t i = 0; i < nodeCount; ++i)
+		for (std::size_t connection : outputsOf(i))
+			if (connection != ~0ULL)
+				++driverOffsets[connection + 1];
+	for (std::size_t i = 0; i < connectionCount; ++i)
+		driverOffsets[i + 1] += driverOffsets[i];
+
+	std::vector<std::size_t> drivers(driverOffsets[connectionCount]);
+	{
+		std::vector<std::size_t> fill(driverOffsets.begin(), driverOffsets.end() - 1);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+			for (std::size_t connection : outputsOf(i))
+				if (connection != ~0ULL)
+					drivers[fill[connection]++] = i;
+	}
+
+	// Build node -> dependent node edges
+	std::vector<std::size_t> pending(nodeCount, 0);
+	std::vector<std::size_t> dependentOffsets(nodeCount + 1, 0);
+	for (std::size_t i = 0; i < nodeCount; ++i)
+	{
+		for (std::size_t connection : inputsOf(i))
+		{
+			if (connection == ~0ULL)
+				continue;
+			for (std::size_t j = driverOffsets[connection]; j < driverOffsets[connection + 1]; ++j)
+			{
+				++dependentOffsets[drivers[j] + 1];
+				++pending[i];
+			}
+		}
+	}
+	for (std::size_t i = 0; i < nodeCount; ++i)
+		dependentOffsets[i + 1] += dependentOffsets[i];
+
+	std::vector<std::size_t> dependents(dependentOffsets[nodeCount]);
+	{
+		std::vector<std::size_t> fill(dependentOffsets.begin(), dependentOffsets.end() - 1);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			for (std::size_t connection : inputsOf(i))
+			{
+				if (connection == ~0ULL)
+					continue;
+				for (std::size_t j = driverOffsets[connection]; j < driverOffsets[connection + 1]; ++j)
+					dependents[fill[drivers[j]]++] = i;
+			}
+		}
+	}
+
+	// Peel off levels, every node in a level only depends on nodes in previous levels
+	m_Order.reserve(nodeCount);
+	for (std::size_t i = 0; i < nodeCount; ++i)
+		if (pending[i] == 0)
+			m_Order.push_back(i);
+
+	std::size_t levelStart = 0;
+	while (levelStart != m_Order.size())
+	{
+		std::size_t levelEnd = m_Order.size();
+		m_LevelOffsets.push_back(levelStart);
+		for (std::size_t i = levelStart; i < levelEnd; ++i)
+		{
+			std::size_t node = m_Order[i];
+			for (std::size_t j = dependentOffsets[node]; j < dependentOffsets[node + 1]; ++j)
+				if (--pending[dependents[j]] == 0)
+					m_Order.push_back(dependents[j]);
+		}
+		// Keep every level in node order, so the order is deterministic and levelizing an already levelized list is the identity
+		std::sort(m_Order.begin() + levelEnd, m_Order.end());
+		levelStart = levelEnd;
+	}
+	m_LevelOffsets.push_back(levelStart);
+	m_FeedbackOffset = m_Order.size();
+
+	// Whatever is left is stuck behind a feedback loop, split it into strongly connected components with Tarjan's algorithm
+	std::vector<std::size_t> component(nodeCount, ~0ULL);
+	std::size_t              componentCount = 0;
+	{
+		std::vector<std::size_t>                         index(nodeCount, ~0ULL);
+		std::vector<std::size_t>                         lowLink(nodeCount, 0);
+		std::vector<std::size_t>                         stack;
+		std::vector<std::pair<std::size_t, std::size_t>> callStack;
+		std::size_t                                      nextIndex = 0;
+		for (std::size_t root = 0; root < nodeCount; ++root)
+		{
+			if (pending[root] == 0 || index[root] != ~0ULL)
+				continue;
+
+			callStack.emplace_back(root, dependentOffsets[root]);
+			index[root] = lowLink[root] = nextIndex++;
+			stack.push_back(root);
+			while (!callStack.empty())
+			{
+				auto& [node, edge] = callStack.back();
+				if (edge != dependentOffsets[node + 1])
+				{
+					std::size_t dependent = dependents[edge++];
+					if (index[dependent] == ~0ULL)
+					{
+						index[dependent] = lowLink[dependent] = nextIndex++;
+						stack.push_back(dependent);
+						callStack.emplace_back(dependent, dependentOffsets[dependent]);
+					}
+					else if (component[dependent] == ~0ULL)
+					{
+						lowLink[node] = std::min(lowLink[node], index[dependent]);
+					}
+					continue;
+				}
+
+				std::size_t finished = node;
+				callStack.pop_back();
+				if (!callStack.empty())
+					lowLink[callStack.back().first] = std::min(lowLink[callStack.back().first], lowLink[finished]);
+				if (lowLink[finished] != index[finished])
+					continue;
+
+				std::size_t member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					component[member] = componentCount;
+				}
+				while (member != finished);
+				++componentCount;
+			}
+		}
+	}
+
+	// Order the components topologically, picking the component with the lowest node first so the order is deterministic
+	{
+		std::vector<std::size_t> componentMin(componentCount, ~0ULL);
+		std::vector<std::size_t> componentPending(componentCount, 0);
+		std::vector<bool>        componentCyclic(componentCount, false);
+		std::vector<std::size_t> memberOffsets(componentCount + 1, 0);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			if (component[i] == ~0ULL)
+				continue;
+			componentMin[component[i]] = std::min(componentMin[component[i]], i);
+			++memberOffsets[component[i] + 1];
+			for (std::size_t j = dependentOffsets[i]; j < dependentOffsets[i + 1]; ++j)
+			{
+				if (component[dependents[j]] != component[i])
+					++componentPending[component[dependents[j]]];
+				else
+					componentCyclic[component[i]] = true;
+			}
+		}
+		for (std::size_t i = 0; i < componentCount; ++i)
+			memberOffsets[i + 1] += memberOffsets[i];
+
+		std::vector<std::size_t> members(memberOffsets[componentCount]);
+		{
+			std::vector<std::size_t> fill(memberOffsets.begin(), memberOffsets.end() - 1);
+			for (std::size_t i = 0; i < nodeCount; ++i)
+				if (component[i] != ~0ULL)
+					members[fill[component[i]]++] = i;
+		}
+
+		std::vector<std::pair<std::size_t, std::size_t>> ready;
+		for (std::size_t i = 0; i < componentCount; ++i)
+			if (componentPending[i] == 0)
+				ready.emplace_back(componentMin[i], i);
+		std::make_heap(ready.begin(), ready.end(), std::greater<> {});
+		while (!ready.empty())
+		{
+			std::pop_heap(ready.begin(), ready.end(), std::greater<> {});
+			std::size_t current = ready.back().second;
+			ready.pop_back();
+
+			m_ComponentOffsets.push_back(m_Order.size());
+			m_CyclicComponents.push_back(componentCyclic[current]);
+			for (std::size_t j = memberOffsets[current]; j < memberOffsets[current + 1]; ++j)
+			{
+				std::size_t node = members[j];
+				m_Order.push_back(node);
+				for (std::size_t k = dependentOffsets[node]; k < dependentOffsets[node + 1]; ++k)
+				{
+					std::size_t dependent = component[dependents[k]];
+					if (dependent != current && --componentPending[dependent] == 0)
+					{
+						ready.emplace_back(componentMin[dependent], dependent);
+						std::push_heap(ready.begin(), ready.end(), std::greater<> {});
+					}
+				}
+			}
+		}
+		m_ComponentOffsets.push_back(m_Order.size());
+	}
+
+	// Build the fanout of every connection in schedule indices
+	m_FanoutOffsets.resize(connectionCount + 1, 0);
+	for (std::size_t i = 0; i < nodeCount; ++i)
+		for (std::size_t connection : inputsOf(i))
+			if (connection != ~0ULL)
+				++m_FanoutOffsets[connection + 1];
+	for (std::size_t i = 0; i < connectionCount; ++i)
+		m_FanoutOffsets[i + 1] += m_FanoutOffsets[i];
+
+	m_Fanout.resize(m_FanoutOffsets[connectionCount]);
+	{
+		std::vector<std::size_t> fill(m_FanoutOffsets.begin(), m_FanoutOffsets.end() - 1);
+		for (std::size_t i = 0; i < m_Order.size(); ++i)
+		{
+			for (std::size_t connection : inputsOf(m_Order[i]))
+			{
+				if (connection == ~0ULL)
+					continue;
+				// Skip duplicate entries for nodes reading the same connection on multiple ports
+				if (fill[connection] != m_FanoutOffsets[connection] && m_Fanout[fill[connection] - 1] == i)
+					continue;
+				m_Fanout[fill[connection]++] = i;
+			}
+		}
+
+		// Compact away the holes left by duplicates
+		std::size_t out = 0;
+		for (std::size_t i = 0; i < connectionCount; ++i)
+		{
+			std::size_t begin  = m_FanoutOffsets[i];
+			m_FanoutOffsets[i] = out;
+			for (std::size_t j = begin; j < fill[i]; ++j)
+				m_Fanout[out++] = m_Fanout[j];
+		}
+		m_FanoutOffsets[connectionCount] = out;
+		m_Fanout.resize(out);
+	}
+}
\ No newline at end of file
@@ -1,43 +1,95 @@
 #pragma once
 
+#include "TruthTablePool.h"
 #include "Utils/BitSet.h"
 #include "Utils/Utils.h"
 
+#include <bit>
+#include <memory>
+
+enum class TruthTableLayout
+{
+	Dense,  // Rows are exactly outputCount() bits wide
+	Aligned // Rows are padded to a power of two width, so a row never straddles a word and can be read with a single load
+};
+
 struct TruthTable
 {
 public:
 	using FillerFunctionType = void (*)(std::uint16_t input, std::size_t bit, BitSet& bitSet);
 
+	// Row width in bits for `numOutputs` outputs, layouts only differ for up to 64 outputs
+	static std::size_t RowBits(std::size_t numOutputs, TruthTableLayout layout)
+	{
+		return layout == TruthTableLayout::Aligned && numOutputs <= 64 ? std::bit_ceil(std::max<std::size_t>(numOutputs, 1)) : numOutputs;
+	}
+
 public:
+	// The filler is called once per row with the first bit of that row, the filled rows are interned in TruthTablePool
 	template <Callable<void, std::uint16_t, std::size_t, BitSet&> F>
-	TruthTable(std::uint8_t numInputs, std::size_t numOutputs, F&& filler)
-	    : m_Outputs((1ULL << numInputs) * numOutputs),
+	TruthTable(std::uint8_t numInputs, std::size_t numOutputs, F&& filler, TruthTableLayout layout = TruthTableLayout::Aligned)
+	    : TruthTable(numInputs, numOutputs, Fill(numInputs, RowBits(numOutputs, layout), filler), layout) {}
+	// Takes rows that were already filled, every row starting RowBits(numOutputs, layout) bits after the previous one
+	TruthTable(std::uint8_t numInputs, std::size_t numOutputs, BitSet&& rows, TruthTableLayout layout = TruthTableLayout::Aligned)
+	    : m_Outputs(TruthTablePool::Intern(std::move(rows))),
 	      m_MaxPossibilities(static_cast<std::uint32_t>(1 << numInputs)),
 	      m_NumInputs(numInputs),
-	      m_NumOutputs(numOutputs)
+	      m_NumOutputs(numOutputs),
+	      m_RowBits(RowBits(numOutputs, layout)),
+	      m_RowShift(static_cast<std::uint8_t>(std::countr_zero(m_RowBits))),
+	      m_RowMask(numOutputs >= 64 ? ~0ULL : (1ULL << numOutputs) - 1) {}
+
+	void getOutput(std::uint16_t inputs, BitSpan outputs) const
 	{
-		for (std::uint16_t i = 0; i < m_MaxPossibilities; ++i)
-			filler(i, i * m_NumOutputs, m_Outputs);
+		m_Outputs->getBits(outputs, 0, inputs * m_RowBits, m_NumOutputs);
 	}
 
-	void getOutput(std::uint16_t inputs, BitSet& outputs) const
+	bool getOutput(std::uint16_t inputs, std::size_t output) const
 	{
-		m_Outputs.getBits(outputs, 0, inputs * m_NumOutputs, m_NumOutputs);
+		return m_Outputs->get(inputs * m_RowBits + output);
 	}
 
+	// Every output of a row as the low bits of a word, only valid when isAligned()
+	std::uint64_t getRow(std::uint16_t inputs) const
+	{
+		std::size_t bit = static_cast<std::size_t>(inputs) << m_RowShift;
+		return m_Outputs->data()[bit / BitSet::c_WordBits] >> (bit % BitSet::c_WordBits) & m_RowMask;
+	}
+
+	bool isAligned() const { return m_RowBits <= 64 && std::has_single_bit(m_RowBits); }
+
 	std::size_t allocatedSize() const
 	{
 		std::size_t staticSize = sizeof(*this);
-		staticSize += m_Outputs.size() >> 3;
+		if (m_Outputs)
+			staticSize += m_Outputs->allocatedSizeOf() / m_Outputs.use_count();
 		return staticSize;
 	}
 
 	std::size_t inputCount() const { return m_NumInputs; }
 	std::size_t outputCount() const { return m_NumOutputs; }
+	std::size_t rowBits() const { return m_RowBits; }
+
+	// Raw rows, every row starts rowBits() bits after the previous one
+	const BitSet& getRows() const { return *m_Outputs; }
+
+private:
+	template <class F>
+	static BitSet Fill(std::uint8_t numInputs, std::size_t rowBits, F& filler)
+	{
+		BitSet rows((1ULL << numInputs) * rowBits);
+		for (std::uint32_t i = 0; i < (1U << numInputs); ++i)
+			filler(static_cast<std::uint16_t>(i), i * rowBits, rows);
+		return rows;
+	}
 
 private:
-	BitSet        m_Outputs;
+	std::shared_ptr<const BitSet> m_Outputs;
+
 	std::uint32_t m_MaxPossibilities : 24;
 	std::uint32_t m_NumInputs : 8;
 	std::size_t   m_NumOutputs;
+	std::size_t   m_RowBits;
+	std::uint8_t  m_RowShift;
+	std::uint64_t m_RowMask;
 };
\ No newline at end of file
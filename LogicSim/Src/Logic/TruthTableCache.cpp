@@ -0,0 +1,274 @@
+#include "TruthTableCache.h"
+#include "Component.h"
+#include "Utils/Log.h"
+#include "Utils/ThreadPool.h"
+
+#include <cstdio>
+
+#include <fstream>
+#include <random>
+#include <unordered_map>
+
+//---------
+// Hashing
+//---------
+
+// Only fixed width values go into the hash, so keys stay equal across compilers and runs
+struct StructuralHasher
+{
+public:
+	static std::uint64_t Mix(std::uint64_t hash, std::uint64_t value)
+	{
+		hash ^= value + 0x9E37'79B9'7F4A'7C15ULL + (hash << 6) + (hash >> 2);
+		hash *= 0xFF51'AFD7'ED55'8CCDULL;
+		return hash ^ (hash >> 33);
+	}
+
+	static std::uint64_t Mix(std::uint64_t hash, std::string_view text)
+	{
+		hash = Mix(hash, text.size());
+		for (char c : text)
+			hash = Mix(hash, static_cast<std::uint8_t>(c));
+		return hash;
+	}
+
+	static std::uint64_t Mix(std::uint64_t hash, const BitSet& bits)
+	{
+		hash = Mix(hash, bits.size());
+		for (std::size_t i = 0; i < bits.wordCount(); ++i)
+			hash = Mix(hash, bits.data()[i]);
+		return hash;
+	}
+
+	static std::uint64_t Mix(std::uint64_t hash, const TruthTable& truthTable)
+	{
+		hash = Mix(hash, truthTable.inputCount());
+		hash = Mix(hash, truthTable.outputCount());
+		hash = Mix(hash, truthTable.rowBits());
+		return Mix(hash, truthTable.getRows());
+	}
+
+public:
+	std::uint64_t hash(const Graph& graph)
+	{
+		std::uint64_t hash = Mix(0, graph.inputCount());
+		hash               = Mix(hash, graph.outputCount());
+		hash               = Mix(hash, graph.connectionCount());
+		for (std::size_t connection : graph.getInputPorts())
+			hash = Mix(hash, connection);
+		for (std::size_t connection : graph.getOutputPorts())
+			hash = Mix(hash, connection);
+		for (auto& node : graph.getNodes())
+		{
+			hash = Mix(hash, node.index());
+			hash = Mix(hash, this->hash(*node->getComponent()));
+			for (std::size_t connection : graph.getInputPorts(*node))
+				hash = Mix(hash, connection);
+			for (std::size_t connection : graph.getOutputPorts(*node))
+				hash = Mix(hash, connection);
+		}
+		return hash;
+	}
+
+	// Covers whichever representation Netlist flattens, in the same order of preference
+	std::uint64_t hash(const Component& component)
+	{
+		auto itr = m_Components.find(&component);
+		if (itr != m_Components.end())
+			return itr->second;
+
+		std::uint64_t hash = Mix(0, component.getName().m_Namespace);
+		hash               = Mix(hash, component.getName().m_Name);
+		hash               = Mix(hash, component.inputCount());
+		hash               = Mix(hash, component.outputCount());
+		if (component.hasGate())
+		{
+			hash = Mix(Mix(hash, 1), static_cast<std::uint64_t>(component.getGate()));
+		}
+		else if (component.hasTruthTable())
+		{
+			hash = Mix(Mix(hash, 2), component.getTruthTable());
+		}
+		else if (component.hasGraph())
+		{
+			hash = Mix(Mix(hash, 3), this->hash(component.getGraph()));
+		}
+		else if (component.hasConeTable())
+		{
+			hash = Mix(hash, 4);
+			for (auto& cone : component.getConeTable().getCones())
+			{
+				for (std::uint32_t input : cone.m_Inputs)
+					hash = Mix(hash, input);
+				for (std::uint32_t output : cone.m_Outputs)
+					hash = Mix(hash, output);
+				hash = Mix(hash, cone.m_TruthTable);
+			}
+		}
+		else if (component.hasDecisionDiagram())
+		{
+			auto& diagram = component.getDecisionDiagram();
+			hash          = Mix(hash, 5);
+			for (auto& decision : diagram.getNodes())
+				hash = Mix(Mix(Mix(hash, decision.m_Level), decision.m_Low), decision.m_High);
+			for (std::uint32_t root : diagram.getRoots())
+				hash = Mix(hash, root);
+			for (std::uint32_t input : diagram.getOrder())
+				hash = Mix(hash, input);
+		}
+		m_Components.emplace(&component, hash);
+		return hash;
+	}
+
+private:
+	// Components shared by many graphs are only hashed once
+	std::unordered_map<const Component*, std::uint64_t> m_Components;
+};
+
+std::uint64_t TruthTableCache::HashGraph(const Graph& graph)
+{
+	StructuralHasher hasher;
+	return StructuralHasher::Mix(hasher.hash(graph), c_Version);
+}
+
+//-------
+// Cache
+//-------
+
+TruthTableCache::TruthTableCache(std::filesystem::path directory)
+    : m_Directory(std::move(directory))
+{
+	std::error_code error;
+	std::filesystem::create_directories(m_Directory, error);
+	if (error)
+		Log::Warn("Failed to create truth table cache directory '{}'", m_Directory.string());
+}
+
+std::optional<TruthTable> TruthTableCache::compile(const Graph& graph)
+{
+	if (!graph.compilable())
+		return graph.compile();
+
+	std::uint64_t key = HashGraph(graph);
+	if (auto truthTable = load(graph, key))
+		return truthTable;
+
+	auto truthTable = graph.compile();
+	if (truthTable)
+		store(key, *truthTable);
+	return truthTable;
+}
+
+std::optional<TruthTable> TruthTableCache::compile(const Graph& graph, ThreadPool& pool)
+{
+	if (!graph.compilable())
+		return graph.compile(pool);
+
+	std::uint64_t key = HashGraph(graph);
+	if (auto truthTable = load(graph, key))
+		return truthTable;
+
+	auto truthTable = graph.compile(pool);
+	if (truthTable)
+		store(key, *truthTable);
+	return truthTable;
+}
+
+std::optional<TruthTable> TruthTableCache::load(const Graph& graph, std::uint64_t key) const
+{
+	auto truthTable = load(key);
+	if (truthTable && (truthTable->inputCount() != graph.inputCount() || truthTable->outputCount() != graph.outputCount()))
+	{
+		Log::Warn("Truth table cache entry '{}' has {} inputs and {} outputs, expected {} and {}", path(key).string(), truthTable->inputCount(), truthTable->outputCount(), graph.inputCount(), graph.outputCount());
+		return std::nullopt;
+	}
+	return truthTable;
+}
+
+std::optional<TruthTable> TruthTableCache::load(std::uint64_t key) const
+{
+	std::filesystem::path filePath = path(key);
+	std::ifstream         file { filePath, std::ios::binary | std::ios::ate };
+	if (!file)
+		return std::nullopt;
+	std::size_t size = static_cast<std::size_t>(file.tellg());
+	file.seekg(0);
+
+	Header header;
+	if (size < sizeof(Header) || !file.read(reinterpret_cast<char*>(&header), sizeof(Header)))
+	{
+		Log::Warn("Truncated truth table cache entry '{}'", filePath.string());
+		return std::nullopt;
+	}
+
+	// Rows have to be one of the widths a table of that many outputs reads them at, anything else would be read out of bounds
+	std::size_t words       = BitSet::WordCount(header.m_Bits);
+	std::size_t alignedBits = TruthTable::RowBits(header.m_NumOutputs, TruthTableLayout::Aligned);
+	if (header.m_Magic != c_Magic || header.m_Version != c_Version || header.m_Key != key || header.m_NumInputs > 16 ||
+	    (header.m_RowBits != alignedBits && header.m_RowBits != header.m_NumOutputs) || header.m_RowBits > (~0ULL >> 16) ||
+	    header.m_Bits != (1ULL << header.m_NumInputs) * header.m_RowBits || size != sizeof(Header) + words * sizeof(std::uint64_t))
+	{
+		Log::Warn("Invalid truth table cache entry '{}'", filePath.string());
+		return std::nullopt;
+	}
+
+	// Read straight into the row words, the table interns them without another copy
+	BitSet rows(header.m_Bits);
+	if (!file.read(reinterpret_cast<char*>(rows.data()), words * sizeof(std::uint64_t)))
+	{
+		Log::Warn("Failed to read truth table cache entry '{}'", filePath.string());
+		return std::nullopt;
+	}
+	if (header.m_Bits % BitSet::c_WordBits)
+		rows.data()[words - 1] &= (1ULL << (header.m_Bits % BitSet::c_WordBits)) - 1;
+	TruthTableLayout layout = header.m_RowBits == alignedBits ? TruthTableLayout::Aligned : TruthTableLayout::Dense;
+	return TruthTable { static_cast<std::uint8_t>(header.m_NumInputs), header.m_NumOutputs, std::move(rows), layout };
+}
+
+bool TruthTableCache::store(std::uint64_t key, const TruthTable& truthTable) const
+{
+	auto&  rows = truthTable.getRows();
+	Header header {
+		c_Magic,
+		c_Version,
+		static_cast<std::uint32_t>(truthTable.inputCount()),
+		key,
+		truthTable.outputCount(),
+		truthTable.rowBits(),
+		rows.size()
+	};
+
+	std::filesystem::path filePath = path(key);
+	std::filesystem::path tempPath = filePath;
+	tempPath += "." + std::to_string(std::random_device {}()) + ".tmp";
+	{
+		std::ofstream file { tempPath, std::ios::binary | std::ios::trunc };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(reinterpret_cast<const char*>(rows.data()), rows.wordCount() * sizeof(std::uint64_t));
+		if (!file)
+		{
+			Log::Warn("Failed to write truth table cache entry '{}'", tempPath.string());
+			file.close();
+			std::error_code error;
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, filePath, error);
+	if (error)
+	{
+		Log::Warn("Failed to move truth table cache entry into '{}'", filePath.string());
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
+
+std::filesystem::path TruthTableCache::path(std::uint64_t key) const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.ltt", static_cast<unsigned long long>(key));
+	return m_Directory / name;
+}
\ No newline at end of file
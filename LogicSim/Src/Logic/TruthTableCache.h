@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Graph.h"
+#include "TruthTable.h"
+
+#include <cstdint>
+
+#include <filesystem>
+#include <optional>
+
+struct ThreadPool;
+
+// Compiled truth tables persisted on disk, keyed by the structure of the graph they were compiled from.
+// Every table is one file holding a fixed header followed by the raw row words, so a warm start reads the rows straight into the table instead of enumerating the graph.
+// Files are written to a temporary name and renamed into place, so processes sharing a directory never see a partial table.
+struct TruthTableCache
+{
+public:
+	static constexpr std::uint64_t c_Magic   = 0x3130'5454'4D49'534CULL; // "LSIMTT01"
+	static constexpr std::uint32_t c_Version = 1;
+
+	// Hash of `graph` and every component it references, graphs with equal hashes compile to the same table
+	static std::uint64_t HashGraph(const Graph& graph);
+
+public:
+	TruthTableCache(std::filesystem::path directory);
+
+	// Returns the cached table for `graph`, compiling and storing it first on a miss or when the cached table has another shape.
+	// Nothing unless graph.compilable(), same as Graph::compile()
+	std::optional<TruthTable> compile(const Graph& graph);
+	std::optional<TruthTable> compile(const Graph& graph, ThreadPool& pool);
+
+	std::optional<TruthTable> load(std::uint64_t key) const;
+	bool                      store(std::uint64_t key, const TruthTable& truthTable) const;
+
+	std::filesystem::path path(std::uint64_t key) const;
+
+	auto& getDirectory() const { return m_Directory; }
+
+private:
+	// Only accepts an entry with the inputs and outputs of `graph`, a colliding key would otherwise install a table of the wrong shape
+	std::optional<TruthTable> load(const Graph& graph, std::uint64_t key) const;
+
+private:
+	struct Header
+	{
+	public:
+		std::uint64_t m_Magic;
+		std::uint32_t m_Version;
+		std::uint32_t m_NumInputs;
+		std::uint64_t m_Key;
+		std::uint64_t m_NumOutputs;
+		std::uint64_t m_RowBits;
+		std::uint64_t m_Bits;
+	};
+
+private:
+	std::filesystem::path m_Directory;
+};
\ No newline at end of file
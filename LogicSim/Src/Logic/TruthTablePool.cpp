@@ -0,0 +1,74 @@
+#include "TruthTablePool.h"
+
+#include <bit>
+#include <mutex>
+#include <unordered_map>
+
+namespace TruthTablePool
+{
+	struct Pool
+	{
+	public:
+		Pool() : m_PurgeThreshold(64) {}
+
+	public:
+		std::mutex                                                          m_Mutex;
+		std::unordered_multimap<std::uint64_t, std::weak_ptr<const BitSet>> m_Entries;
+		std::size_t                                                         m_PurgeThreshold;
+	};
+
+	static Pool& GetPool()
+	{
+		static Pool s_Pool;
+		return s_Pool;
+	}
+
+	static std::uint64_t Hash(const BitSet& rows)
+	{
+		std::uint64_t hash = rows.size() * 0x9E37'79B9'7F4A'7C15ULL;
+		for (std::size_t i = 0; i < rows.wordCount(); ++i)
+			hash = std::rotl(hash ^ rows.data()[i], 27) * 0x9E37'79B9'7F4A'7C15ULL;
+		return hash ^ (hash >> 31);
+	}
+
+	// Drops entries whose tables are all gone, only once the pool has doubled in size since the last purge
+	static void Purge(Pool& pool)
+	{
+		if (pool.m_Entries.size() < pool.m_PurgeThreshold)
+			return;
+
+		std::erase_if(pool.m_Entries, [](const auto& entry) { return entry.second.expired(); });
+		pool.m_PurgeThreshold = std::max<std::size_t>(pool.m_Entries.size() * 2, 64);
+	}
+
+	std::shared_ptr<const BitSet> Intern(BitSet&& rows)
+	{
+		std::uint64_t hash = Hash(rows);
+		auto&         pool = GetPool();
+		std::lock_guard lock { pool.m_Mutex };
+
+		auto [begin, end] = pool.m_Entries.equal_range(hash);
+		for (auto itr = begin; itr != end; ++itr)
+		{
+			auto existing = itr->second.lock();
+			if (existing && *existing == rows)
+				return existing;
+		}
+
+		Purge(pool);
+		auto shared = std::make_shared<const BitSet>(std::move(rows));
+		pool.m_Entries.emplace(hash, shared);
+		return shared;
+	}
+
+	std::size_t Size()
+	{
+		auto&           pool = GetPool();
+		std::lock_guard lock { pool.m_Mutex };
+
+		std::size_t count = 0;
+		for (auto& entry : pool.m_Entries)
+			count += !entry.second.expired();
+		return count;
+	}
+} // namespace TruthTablePool
\ No newline at end of file
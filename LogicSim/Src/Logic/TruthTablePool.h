@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Utils/BitSet.h"
+
+#include <memory>
+
+// Content addressed store for truth table rows, identical tables share one immutable buffer.
+// Buffers are refcounted by the tables using them and leave the pool once the last of those tables is destroyed.
+namespace TruthTablePool
+{
+	// Returns the shared buffer holding the same bits as `rows`, adding `rows` to the pool when there is none yet
+	std::shared_ptr<const BitSet> Intern(BitSet&& rows);
+
+	// Number of distinct buffers currently alive
+	std::size_t Size();
+} // namespace TruthTablePool
\ No newline at end of file
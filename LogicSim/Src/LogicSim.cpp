@@ -27,5 +27,7 @@ LogicSim::ComponentRef LogicSim::getComponent(NamespaceName name, std::size_t mi
 			closestInputCount = inputCount;
 		}
 	}
+	if (closestComp.valid())
+		m_Dependencies.refresh(closestComp.index());
 	return closestComp;
 }
\ No newline at end of file
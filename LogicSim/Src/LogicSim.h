@@ -1,8 +1,13 @@
 #pragma once
 
 #include "Logic/Component.h"
+#include "Logic/DependencyTracker.h"
+#include "Logic/RevisionSet.h"
+#include "Logic/TruthTableCache.h"
 #include "ResourceManager/ResourceManager.h"
 
+#include <filesystem>
+#include <memory>
 #include <unordered_map>
 
 class LogicSim
@@ -22,11 +27,27 @@ public:
 	}
 	void removeComponent(ComponentRef component)
 	{
+		m_Dependencies.remove(component.index());
 		m_Components.erase(component.index());
+		// Netlists and states over the removed component only look it up again once the edit revision moved
+		RevisionSet::NextRevision();
 	}
 
+	// Components edited since their last use are recompiled before being returned, along with the components they use
 	ComponentRef getComponent(NamespaceName name, std::size_t minInputCount);
 	auto&        getComponents() const { return m_Components; }
+	auto&        getDependencies() { return m_Dependencies; }
+
+	// Persists compiled truth tables in `directory`, so later runs map them instead of compiling again
+	void setCacheDirectory(const std::filesystem::path& directory)
+	{
+		m_TruthTableCache = std::make_unique<TruthTableCache>(directory);
+		m_Dependencies.setCache(m_TruthTableCache.get());
+	}
+	TruthTableCache* getTruthTableCache() { return m_TruthTableCache.get(); }
+
+	// Compiles truth tables across `pool`, which has to outlive its use here, nullptr compiles on the calling thread
+	void setThreadPool(ThreadPool* pool) { m_Dependencies.setThreadPool(pool); }
 
 private:
 	LogicSim()  = default;
@@ -34,4 +55,6 @@ private:
 
 private:
 	ResourceManager::ResourcePool<Component> m_Components;
+	DependencyTracker                        m_Dependencies { m_Components };
+	std::unique_ptr<TruthTableCache>         m_TruthTableCache;
 };
\ No newline at end of file
@@ -25,101 +25,12 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
 
 	for (i = 2; i < 9; ++i)
 	{
-		auto andC = logicSim.newComponent("builtin:and"_nn, builtinIONameFiller);
-		andC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 1;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q *= (inputs >> j) & 1;
-				        bitSet.set(bit, Q);
-				    }
-			    };
-		    });
-
-		auto orC = logicSim.newComponent("builtin:or"_nn, builtinIONameFiller);
-		orC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 0;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q += (inputs >> j) & 1;
-				        bitSet.set(bit, Q >= 1);
-				    }
-			    };
-		    });
-
-		auto nandC = logicSim.newComponent("builtin:nand"_nn, builtinIONameFiller);
-		nandC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 1;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q *= (inputs >> j) & 1;
-				        bitSet.set(bit, !Q);
-				    }
-			    };
-		    });
-
-		auto norC = logicSim.newComponent("builtin:nor"_nn, builtinIONameFiller);
-		norC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 0;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q += (inputs >> j) & 1;
-				        bitSet.set(bit, Q == 0);
-				    }
-			    };
-		    });
-
-		auto xorC = logicSim.newComponent("builtin:xor"_nn, builtinIONameFiller);
-		xorC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 0;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q += (inputs >> j) & 1;
-				        bitSet.set(bit, Q == 1);
-				    }
-			    };
-		    });
-
-		auto xnorC = logicSim.newComponent("builtin:xnor"_nn, builtinIONameFiller);
-		xnorC->setTruthTable(
-		    [i]() -> TruthTable
-		    {
-			    return TruthTable {
-				    i, 1,
-				    [i](std::uint16_t inputs, std::size_t bit, BitSet& bitSet)
-				    {
-				        std::size_t Q = 0;
-				        for (std::size_t j = 0; j < i; ++j)
-					        Q += (inputs >> j) & 1;
-				        bitSet.set(bit, Q != 1);
-				    }
-			    };
-		    });
+		logicSim.newComponent("builtin:and"_nn, builtinIONameFiller)->setGate(GateOp::And);
+		logicSim.newComponent("builtin:or"_nn, builtinIONameFiller)->setGate(GateOp::Or);
+		logicSim.newComponent("builtin:nand"_nn, builtinIONameFiller)->setGate(GateOp::Nand);
+		logicSim.newComponent("builtin:nor"_nn, builtinIONameFiller)->setGate(GateOp::Nor);
+		logicSim.newComponent("builtin:xor"_nn, builtinIONameFiller)->setGate(GateOp::Xor);
+		logicSim.newComponent("builtin:xnor"_nn, builtinIONameFiller)->setGate(GateOp::Xnor);
 	}
 
 	logicSim.removeComponent(logicSim.getComponent("builtin:and"_nn, 3));
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ResourceManager/PinnedRef.h"
+#include "ResourceManager/ResourcePool.h"
+
+namespace ResourceManager
+{
+	template <class T, class IndexType>
+	PinnedRef<T, IndexType>::PinnedRef()
+	    : m_Pool(nullptr), m_Index(0), m_Pointer(nullptr), m_Epoch(0)
+	{
+	}
+
+	template <class T, class IndexType>
+	PinnedRef<T, IndexType>::PinnedRef(ResourcePool* pool, IndexT index)
+	    : m_Pool(pool), m_Index(index), m_Pointer(nullptr), m_Epoch(0)
+	{
+		if (m_Pool)
+			repin(m_Pool->epoch());
+	}
+
+	template <class T, class IndexType>
+	PinnedRef<T, IndexType>::PinnedRef(Ref<T, IndexType> ref)
+	    : PinnedRef(ref.pool(), ref.index())
+	{
+	}
+
+	template <class T, class IndexType>
+	PinnedRef<T, IndexType>::PinnedRef(const PinnedRef& copy)
+	    : m_Pool(copy.m_Pool), m_Index(copy.m_Index), m_Pointer(nullptr), m_Epoch(0)
+	{
+		if (m_Pool)
+			repin(m_Pool->epoch());
+	}
+
+	template <class T, class IndexType>
+	PinnedRef<T, IndexType>& PinnedRef<T, IndexType>::operator=(const PinnedRef& copy)
+	{
+		m_Pool  = copy.m_Pool;
+		m_Index = copy.m_Index;
+		m_Pointer.store(nullptr, std::memory_order_relaxed);
+		m_Epoch.store(0, std::memory_order_relaxed);
+		if (m_Pool)
+			repin(m_Pool->epoch());
+		return *this;
+	}
+
+	template <class T, class IndexType>
+	bool PinnedRef<T, IndexType>::valid() const
+	{
+		return m_Pool;
+	}
+
+	template <class T, class IndexType>
+	T* PinnedRef<T, IndexType>::get()
+	{
+		std::uint64_t epoch = m_Pool->epoch();
+		if (m_Epoch.load(std::memory_order_acquire) != epoch)
+			return repin(epoch);
+		return m_Pointer.load(std::memory_order_relaxed);
+	}
+
+	template <class T, class IndexType>
+	const T* PinnedRef<T, IndexType>::get() const
+	{
+		std::uint64_t epoch = m_Pool->epoch();
+		if (m_Epoch.load(std::memory_order_acquire) != epoch)
+			return repin(epoch);
+		return m_Pointer.load(std::memory_order_relaxed);
+	}
+
+	template <class T, class IndexType>
+	T* PinnedRef<T, IndexType>::repin(std::uint64_t epoch) const
+	{
+		// Concurrent repins all resolve the same address, the pool can't change while they read it
+		T* pointer = m_Pool->getResource(m_Index);
+		m_Pointer.store(pointer, std::memory_order_relaxed);
+		m_Epoch.store(epoch, std::memory_order_release);
+		return pointer;
+	}
+} // namespace ResourceManager
\ No newline at end of file
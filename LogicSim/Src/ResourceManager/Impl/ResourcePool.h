@@ -30,7 +30,7 @@ namespace ResourceManager
 				// On region boundary, extend region, merge with next region if they touch
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
 				iterator->m_End = m_CurrentIndex;
 
 				auto nextIterator = iterator + 1;
@@ -53,7 +53,7 @@ namespace ResourceManager
 				iterator->m_Start = m_CurrentIndex;
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset, m_CurrentIndex, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset, m_CurrentIndex, std::forward<Args>(args)...);
 				nextOptimalIndex();
 
 				if (iterator != m_Regions.begin())
@@ -75,7 +75,7 @@ namespace ResourceManager
 				nextIterator->m_Start = m_CurrentIndex;
 				for (auto it = nextIterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + nextIterator->m_Offset, m_CurrentIndex, std::forward<Args>(args)...);
+				insertResource(nextIterator->m_Offset, m_CurrentIndex, std::forward<Args>(args)...);
 				nextOptimalIndex();
 
 				if (iterator->m_End == nextIterator->m_Start - 1)
@@ -91,7 +91,7 @@ namespace ResourceManager
 				// Between two regions
 				for (auto it = nextIterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
+				insertResource(nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
 				m_Regions.insert(nextIterator, { m_CurrentIndex, m_CurrentIndex, nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) });
 				++m_CurrentIndex;
 				return Ref { this, index };
@@ -101,7 +101,7 @@ namespace ResourceManager
 				// First index
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, m_CurrentIndex, std::forward<Args>(args)...);
 				m_Regions.insert(iterator, { m_CurrentIndex, m_CurrentIndex, iterator->m_Offset + (iterator->m_End - iterator->m_Start) });
 				++m_CurrentIndex;
 				return Ref { this, index };
@@ -110,7 +110,7 @@ namespace ResourceManager
 		else
 		{
 			// New region is last
-			m_Resources.emplace_back(m_CurrentIndex, std::forward<Args>(args)...);
+			insertResource(m_Resources.size(), m_CurrentIndex, std::forward<Args>(args)...);
 			m_Regions.push_back({ m_CurrentIndex, m_CurrentIndex, m_Regions.size() });
 			++m_CurrentIndex;
 			return Ref { this, index };
@@ -129,7 +129,7 @@ namespace ResourceManager
 				// On region boundary, extend region, merge with next region if they touch
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, index, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, index, std::forward<Args>(args)...);
 				iterator->m_End = index;
 
 				auto nextIterator = iterator + 1;
@@ -152,7 +152,7 @@ namespace ResourceManager
 				iterator->m_Start = index;
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset, index, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset, index, std::forward<Args>(args)...);
 				nextOptimalIndex();
 
 				if (iterator != m_Regions.begin())
@@ -174,7 +174,7 @@ namespace ResourceManager
 				nextIterator->m_Start = index;
 				for (auto it = nextIterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + nextIterator->m_Offset, index, std::forward<Args>(args)...);
+				insertResource(nextIterator->m_Offset, index, std::forward<Args>(args)...);
 				nextOptimalIndex();
 
 				if (iterator->m_End == nextIterator->m_Start - 1)
@@ -190,7 +190,7 @@ namespace ResourceManager
 				// Between two regions
 				for (auto it = nextIterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) + 1, index, std::forward<Args>(args)...);
+				insertResource(nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) + 1, index, std::forward<Args>(args)...);
 				m_Regions.insert(nextIterator, { index, index, nextIterator->m_Offset + (nextIterator->m_End - nextIterator->m_Start) });
 				m_CurrentIndex = index + 1;
 				return Ref { this, index };
@@ -200,7 +200,7 @@ namespace ResourceManager
 				// First index
 				for (auto it = iterator + 1; it != m_Regions.end(); ++it)
 					++it->m_Offset;
-				m_Resources.emplace(m_Resources.begin() + iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, index, std::forward<Args>(args)...);
+				insertResource(iterator->m_Offset + (iterator->m_End - iterator->m_Start) + 1, index, std::forward<Args>(args)...);
 				m_Regions.insert(iterator, { index, index, iterator->m_Offset + (iterator->m_End - iterator->m_Start) });
 				m_CurrentIndex = index + 1;
 				return Ref { this, index };
@@ -209,13 +209,34 @@ namespace ResourceManager
 		else
 		{
 			// New region is last
-			m_Resources.emplace_back(index, std::forward<Args>(args)...);
+			insertResource(m_Resources.size(), index, std::forward<Args>(args)...);
 			m_Regions.push_back({ index, index, m_Regions.size() });
 			m_CurrentIndex = index + 1;
 			return Ref { this, index };
 		}
 	}
 
+	template <class T, class IndexType>
+	template <class... Args>
+	ResourcePool<T, IndexType>::Ref ResourcePool<T, IndexType>::emplaceRange(std::size_t count, const Args&... args) requires std::is_constructible_v<T, const Args&...>
+	{
+		IndexT start = m_Regions.empty() ? IndexT { 0 } : m_Regions.back().m_End + 1;
+		if (count == 0)
+			return Ref { this, start };
+
+		m_Resources.reserve(m_Resources.size() + count);
+		for (std::size_t i = 0; i < count; ++i)
+			m_Resources.emplace_back(static_cast<IndexT>(start + i), args...);
+
+		IndexT end = static_cast<IndexT>(start + count - 1);
+		if (!m_Regions.empty() && m_Regions.back().m_End == start - 1)
+			m_Regions.back().m_End = end;
+		else
+			m_Regions.push_back({ start, end, m_Resources.size() - count });
+		nextOptimalIndex();
+		return Ref { this, start };
+	}
+
 	template <class T, class IndexType>
 	void ResourcePool<T, IndexType>::erase(IndexT index)
 	{
@@ -223,6 +244,8 @@ namespace ResourceManager
 		if (region == m_Regions.end())
 			return;
 
+		++m_Epoch;
+
 		if (index == region->m_Start) // On lower boundary, shrink region
 		{
 			m_Resources.erase(m_Resources.begin() + region->m_Offset);
@@ -256,6 +279,47 @@ namespace ResourceManager
 		nextOptimalIndex();
 	}
 
+	template <class T, class IndexType>
+	void ResourcePool<T, IndexType>::eraseMany(std::vector<IndexT> indices)
+	{
+		std::sort(indices.begin(), indices.end());
+		indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+		if (indices.empty() || m_Resources.empty())
+			return;
+
+		// Resources are ordered by index, so the erased ones are found by walking both lists together
+		std::size_t count = 0;
+		auto        next  = indices.begin();
+		for (std::size_t i = 0; i < m_Resources.size(); ++i)
+		{
+			IndexT index = m_Resources[i].index();
+			while (next != indices.end() && *next < index)
+				++next;
+			if (next != indices.end() && *next == index)
+				continue;
+			if (count != i)
+				m_Resources[count] = std::move(m_Resources[i]);
+			++count;
+		}
+		if (count == m_Resources.size())
+			return;
+
+		++m_Epoch;
+		while (m_Resources.size() > count)
+			m_Resources.pop_back();
+
+		m_Regions.clear();
+		for (std::size_t i = 0; i < m_Resources.size(); ++i)
+		{
+			IndexT index = m_Resources[i].index();
+			if (!m_Regions.empty() && m_Regions.back().m_End == index - 1)
+				m_Regions.back().m_End = index;
+			else
+				m_Regions.push_back({ index, index, i });
+		}
+		nextOptimalIndex();
+	}
+
 	template <class T, class IndexType>
 	T* ResourcePool<T, IndexType>::getResource(IndexT index)
 	{
@@ -270,6 +334,16 @@ namespace ResourceManager
 		return ptr ? ptr->value() : nullptr;
 	}
 
+	template <class T, class IndexType>
+	template <class... Args>
+	void ResourcePool<T, IndexType>::insertResource(std::size_t position, IndexT index, Args&&... args)
+	{
+		// Appending never moves resources, anything else shifts every resource after `position`
+		if (position != m_Resources.size())
+			++m_Epoch;
+		m_Resources.emplace(m_Resources.begin() + position, index, std::forward<Args>(args)...);
+	}
+
 	template <class T, class IndexType>
 	void ResourcePool<T, IndexType>::nextOptimalIndex()
 	{
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ResourceManager/SlotPool.h"
+#include "ResourceManager/SlotRef.h"
+
+#include "ResourceManager/Impl/SlotRef.h"
+
+#include <utility>
+
+namespace ResourceManager
+{
+	template <class T, class IndexType>
+	template <class... Args>
+	SlotPool<T, IndexType>::Ref SlotPool<T, IndexType>::emplaceBack(Args&&... args) requires std::is_constructible_v<T, Args...>
+	{
+		IndexT index = nextFreeSlot();
+		m_Resources.emplace_back(index, std::forward<Args>(args)...);
+		auto& slot      = m_Slots[index];
+		slot.m_Position = static_cast<IndexT>(m_Resources.size() - 1);
+		return Ref { this, index, slot.m_Generation };
+	}
+
+	template <class T, class IndexType>
+	template <class... Args>
+	SlotPool<T, IndexType>::Ref SlotPool<T, IndexType>::emplace(IndexT index, Args&&... args) requires std::is_constructible_v<T, Args...>
+	{
+		if (valid(index))
+			return Ref {};
+
+		// Slots skipped over become free, the requested slot may stay listed as free and is skipped later
+		for (IndexT i = static_cast<IndexT>(m_Slots.size()); i < index; ++i)
+		{
+			m_Slots.push_back({ c_Vacant, 0 });
+			m_FreeSlots.push_back(i);
+		}
+		if (index >= m_Slots.size())
+			m_Slots.push_back({ c_Vacant, 0 });
+
+		m_Resources.emplace_back(index, std::forward<Args>(args)...);
+		auto& slot      = m_Slots[index];
+		slot.m_Position = static_cast<IndexT>(m_Resources.size() - 1);
+		return Ref { this, index, slot.m_Generation };
+	}
+
+	template <class T, class IndexType>
+	template <class... Args>
+	SlotPool<T, IndexType>::Ref SlotPool<T, IndexType>::emplaceRange(std::size_t count, const Args&... args) requires std::is_constructible_v<T, const Args&...>
+	{
+		IndexT start = static_cast<IndexT>(m_Slots.size());
+		m_Slots.reserve(m_Slots.size() + count);
+		m_Resources.reserve(m_Resources.size() + count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			m_Slots.push_back({ static_cast<IndexT>(m_Resources.size()), 0 });
+			m_Resources.emplace_back(static_cast<IndexT>(start + i), args...);
+		}
+		return Ref { this, start, 0 };
+	}
+
+	template <class T, class IndexType>
+	void SlotPool<T, IndexType>::erase(IndexT index)
+	{
+		if (!valid(index))
+			return;
+
+		auto&  slot     = m_Slots[index];
+		IndexT position = slot.m_Position;
+		if (position != m_Resources.size() - 1)
+		{
+			// Fill the hole with the last resource
+			m_Resources[position]                             = std::move(m_Resources.back());
+			m_Slots[m_Resources[position].index()].m_Position = position;
+		}
+		m_Resources.pop_back();
+
+		slot.m_Position = c_Vacant;
+		++slot.m_Generation;
+		m_FreeSlots.push_back(index);
+	}
+
+	template <class T, class IndexType>
+	void SlotPool<T, IndexType>::eraseMany(const std::vector<IndexT>& indices)
+	{
+		m_FreeSlots.reserve(m_FreeSlots.size() + indices.size());
+		for (IndexT index : indices)
+			erase(index);
+	}
+
+	template <class T, class IndexType>
+	void SlotPool<T, IndexType>::clear()
+	{
+		m_Resources.clear();
+		m_FreeSlots.clear();
+		for (IndexT i = static_cast<IndexT>(m_Slots.size()); i-- > 0;)
+		{
+			auto& slot = m_Slots[i];
+			if (slot.m_Position != c_Vacant)
+				++slot.m_Generation;
+			slot.m_Position = c_Vacant;
+			m_FreeSlots.push_back(i);
+		}
+	}
+
+	template <class T, class IndexType>
+	void SlotPool<T, IndexType>::reserve(std::size_t count)
+	{
+		m_Slots.reserve(count);
+		m_Resources.reserve(count);
+	}
+
+	template <class T, class IndexType>
+	T* SlotPool<T, IndexType>::getResource(IndexT index)
+	{
+		return valid(index) ? m_Resources[m_Slots[index].m_Position].value() : nullptr;
+	}
+
+	template <class T, class IndexType>
+	const T* SlotPool<T, IndexType>::getResource(IndexT index) const
+	{
+		return valid(index) ? m_Resources[m_Slots[index].m_Position].value() : nullptr;
+	}
+
+	template <class T, class IndexType>
+	T* SlotPool<T, IndexType>::getResource(IndexT index, GenerationT generation)
+	{
+		return valid(index, generation) ? m_Resources[m_Slots[index].m_Position].value() : nullptr;
+	}
+
+	template <class T, class IndexType>
+	const T* SlotPool<T, IndexType>::getResource(IndexT index, GenerationT generation) const
+	{
+		return valid(index, generation) ? m_Resources[m_Slots[index].m_Position].value() : nullptr;
+	}
+
+	template <class T, class IndexType>
+	SlotPool<T, IndexType>::IndexT SlotPool<T, IndexType>::nextFreeSlot()
+	{
+		while (!m_FreeSlots.empty())
+		{
+			IndexT index = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			if (m_Slots[index].m_Position == c_Vacant)
+				return index;
+		}
+
+		m_Slots.push_back({ c_Vacant, 0 });
+		return static_cast<IndexT>(m_Slots.size() - 1);
+	}
+} // namespace ResourceManager
\ No newline at end of file
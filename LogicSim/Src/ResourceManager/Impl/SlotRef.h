@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ResourceManager/SlotPool.h"
+#include "ResourceManager/SlotRef.h"
+
+namespace ResourceManager
+{
+	template <class T, class IndexType>
+	SlotRef<T, IndexType>::SlotRef()
+	    : m_Pool(nullptr), m_Index(0), m_Generation(0)
+	{
+	}
+
+	template <class T, class IndexType>
+	SlotRef<T, IndexType>::SlotRef(SlotPool* pool, IndexT index, GenerationT generation)
+	    : m_Pool(pool), m_Index(index), m_Generation(generation)
+	{
+	}
+
+	template <class T, class IndexType>
+	bool SlotRef<T, IndexType>::valid() const
+	{
+		return m_Pool;
+	}
+
+	template <class T, class IndexType>
+	bool SlotRef<T, IndexType>::alive() const
+	{
+		return m_Pool && m_Pool->valid(m_Index, m_Generation);
+	}
+
+	template <class T, class IndexType>
+	T* SlotRef<T, IndexType>::get()
+	{
+		return m_Pool->getResource(m_Index, m_Generation);
+	}
+
+	template <class T, class IndexType>
+	const T* SlotRef<T, IndexType>::get() const
+	{
+		return m_Pool->getResource(m_Index, m_Generation);
+	}
+
+	template <class T, class IndexType>
+	ConstSlotRef<T, IndexType>::ConstSlotRef()
+	    : m_Pool(nullptr), m_Index(0), m_Generation(0)
+	{
+	}
+
+	template <class T, class IndexType>
+	ConstSlotRef<T, IndexType>::ConstSlotRef(const SlotPool* pool, IndexT index, GenerationT generation)
+	    : m_Pool(pool), m_Index(index), m_Generation(generation)
+	{
+	}
+
+	template <class T, class IndexType>
+	ConstSlotRef<T, IndexType>::ConstSlotRef(SlotRef<T, IndexType> ref)
+	    : m_Pool(ref.pool()), m_Index(ref.index()), m_Generation(ref.generation())
+	{
+	}
+
+	template <class T, class IndexType>
+	bool ConstSlotRef<T, IndexType>::valid() const
+	{
+		return m_Pool;
+	}
+
+	template <class T, class IndexType>
+	bool ConstSlotRef<T, IndexType>::alive() const
+	{
+		return m_Pool && m_Pool->valid(m_Index, m_Generation);
+	}
+
+	template <class T, class IndexType>
+	const T* ConstSlotRef<T, IndexType>::get() const
+	{
+		return m_Pool->getResource(m_Index, m_Generation);
+	}
+} // namespace ResourceManager
\ No newline at end of file
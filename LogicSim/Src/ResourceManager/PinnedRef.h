@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Ref.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+
+namespace ResourceManager
+{
+	template <class T, class IndexType>
+	struct ResourcePool;
+
+	// Ref that caches the address of its resource together with the pool epoch it was resolved in.
+	// Dereferencing only searches the pool again after the pool moved resources around, otherwise it is a compare and a pointer load.
+	// The cached pair is atomic, so readers sharing a ref may repin it concurrently, as long as the pool itself is not modified while they read, same as for plain refs.
+	template <class T, class IndexType = std::size_t>
+	struct PinnedRef
+	{
+	public:
+		using ResourcePool = ResourcePool<T, IndexType>;
+		using IndexT       = IndexType;
+
+	public:
+		PinnedRef();
+		PinnedRef(ResourcePool* pool, IndexT index);
+		PinnedRef(Ref<T, IndexType> ref);
+		PinnedRef(const PinnedRef& copy);
+		PinnedRef& operator=(const PinnedRef& copy);
+
+		inline bool valid() const;
+
+		inline T*       get();
+		inline const T* get() const;
+
+		ResourcePool*       pool() { return m_Pool; }
+		const ResourcePool* pool() const { return m_Pool; }
+		IndexT              index() const { return m_Index; }
+
+		operator Ref<T, IndexType>() const { return { m_Pool, m_Index }; }
+
+		         operator T&() { return *get(); }
+		         operator const T&() const { return *get(); }
+		T*       operator->() { return get(); }
+		const T* operator->() const { return get(); }
+		T&       operator*() { return *get(); }
+		const T& operator*() const { return *get(); }
+
+		friend bool operator==(const PinnedRef& lhs, const PinnedRef& rhs)
+		{
+			return lhs.m_Pool == rhs.m_Pool && lhs.m_Index == rhs.m_Index;
+		}
+		friend bool operator!=(const PinnedRef& lhs, const PinnedRef& rhs) { return !(lhs == rhs); }
+
+	private:
+		inline T* repin(std::uint64_t epoch) const;
+
+	private:
+		ResourcePool* m_Pool;
+		IndexT        m_Index;
+
+		// The epoch is published after the pointer, a reader seeing the current epoch also sees the pointer resolved in it
+		mutable std::atomic<T*>            m_Pointer;
+		mutable std::atomic<std::uint64_t> m_Epoch;
+	};
+} // namespace ResourceManager
\ No newline at end of file
@@ -1,8 +1,14 @@
 #pragma once
 
+#include "PinnedRef.h"
 #include "Ref.h"
 #include "Resource.h"
 #include "ResourcePool.h"
+#include "SlotPool.h"
+#include "SlotRef.h"
 
+#include "Impl/PinnedRef.h"
 #include "Impl/Ref.h"
 #include "Impl/ResourcePool.h"
+#include "Impl/SlotPool.h"
+#include "Impl/SlotRef.h"
\ No newline at end of file
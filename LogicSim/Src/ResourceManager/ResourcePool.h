@@ -2,6 +2,7 @@
 
 #include "Ref.h"
 #include "Resource.h"
+#include "Utils/ChunkedList.h"
 #include "Utils/Region.h"
 
 #include <cstddef>
@@ -21,19 +22,25 @@ namespace ResourceManager
 		using Region       = Utils::Region<IndexType>;
 		using Resource     = Resource<T, IndexType>;
 		using RegionList   = std::vector<Region>;
-		using ResourceList = std::vector<Resource>;
+		using ResourceList = Utils::ChunkedList<Resource>;
 		using IndexT       = IndexType;
 
 	public:
-		ResourcePool() : m_CurrentIndex(0U) {}
+		ResourcePool() : m_CurrentIndex(0U), m_Epoch(0) {}
 
 		bool valid(IndexT index) const;
 
 		template <class... Args>
 		Ref emplaceBack(Args&&... args) requires std::is_constructible_v<T, Args...>;
 		template <class... Args>
-		Ref  emplace(IndexT index, Args&&... args) requires std::is_constructible_v<T, Args...>;
+		Ref emplace(IndexT index, Args&&... args) requires std::is_constructible_v<T, Args...>;
+		// Constructs `count` resources from the same arguments at contiguous indices past the last region, returns a ref to the first one
+		template <class... Args>
+		Ref  emplaceRange(std::size_t count, const Args&... args) requires std::is_constructible_v<T, const Args&...>;
 		void erase(IndexT index);
+		// Erases every listed index in a single pass over the resources, unknown and repeated indices are ignored
+		void eraseMany(std::vector<IndexT> indices);
+		void reserve(std::size_t count) { m_Resources.reserve(count); }
 
 		T*       getResource(IndexT index);
 		const T* getResource(IndexT index) const;
@@ -41,8 +48,10 @@ namespace ResourceManager
 		auto& regions() const { return m_Regions; }
 		auto& resources() const { return m_Resources; }
 		auto  currentIndex() const { return m_CurrentIndex; }
+		// Changes whenever resources move in memory, PinnedRef uses it to tell when its cached address went stale
+		std::uint64_t epoch() const { return m_Epoch; }
 
-		std::size_t allocatedSizeOf() const { return m_Regions.capacity() * sizeof(Region) + m_Resources.capacity() * sizeof(Resource); }
+		std::size_t allocatedSizeOf() const { return m_Regions.capacity() * sizeof(Region) + m_Resources.allocatedSizeOf(); }
 		std::size_t totalSizeOf() const { return sizeof(*this) + allocatedSizeOf(); }
 
 		auto begin() { return m_Resources.begin(); }
@@ -53,6 +62,8 @@ namespace ResourceManager
 		auto cend() const { return m_Resources.cend(); }
 
 	protected:
+		template <class... Args>
+		void insertResource(std::size_t position, IndexT index, Args&&... args);
 		void nextOptimalIndex();
 
 		Resource*       getResourcePtr(IndexT index);
@@ -67,6 +78,7 @@ namespace ResourceManager
 		RegionList   m_Regions;
 		ResourceList m_Resources;
 
-		IndexT m_CurrentIndex;
+		IndexT        m_CurrentIndex;
+		std::uint64_t m_Epoch;
 	};
 } // namespace ResourceManager
\ No newline at end of file
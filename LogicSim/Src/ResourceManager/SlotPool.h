@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Resource.h"
+#include "SlotRef.h"
+#include "Utils/ChunkedList.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <type_traits>
+#include <vector>
+
+namespace ResourceManager
+{
+	// Slot map counterpart of ResourcePool, lookup, insertion and erasure are O(1).
+	// Every index owns a slot holding the position of its resource and a generation, resources stay packed in never reallocated chunks and an erase moves the last resource into the hole.
+	// Erasing bumps the generation of the slot, so refs to an erased resource stop resolving instead of aliasing whatever reuses the index.
+	template <class T, class IndexType = std::size_t>
+	struct SlotPool
+	{
+	public:
+		using Ref          = SlotRef<T, IndexType>;
+		using ConstRef     = ConstSlotRef<T, IndexType>;
+		using Resource     = Resource<T, IndexType>;
+		using ResourceList = Utils::ChunkedList<Resource>;
+		using IndexT       = IndexType;
+		using GenerationT  = std::uint32_t;
+
+		static constexpr IndexT c_Vacant = ~IndexT { 0 };
+
+		struct Slot
+		{
+		public:
+			IndexT      m_Position;
+			GenerationT m_Generation;
+		};
+
+		using SlotList = std::vector<Slot>;
+
+	public:
+		SlotPool() = default;
+
+		bool valid(IndexT index) const { return index < m_Slots.size() && m_Slots[index].m_Position != c_Vacant; }
+		bool valid(IndexT index, GenerationT generation) const { return valid(index) && m_Slots[index].m_Generation == generation; }
+
+		template <class... Args>
+		Ref emplaceBack(Args&&... args) requires std::is_constructible_v<T, Args...>;
+		// Fails with an invalid ref when `index` is already taken
+		template <class... Args>
+		Ref emplace(IndexT index, Args&&... args) requires std::is_constructible_v<T, Args...>;
+		// Constructs `count` resources from the same arguments in fresh slots with contiguous indices, returns a ref to the first one
+		template <class... Args>
+		Ref  emplaceRange(std::size_t count, const Args&... args) requires std::is_constructible_v<T, const Args&...>;
+		void erase(IndexT index);
+		void eraseMany(const std::vector<IndexT>& indices);
+		void clear();
+		void reserve(std::size_t count);
+
+		inline T*       getResource(IndexT index);
+		inline const T* getResource(IndexT index) const;
+		inline T*       getResource(IndexT index, GenerationT generation);
+		inline const T* getResource(IndexT index, GenerationT generation) const;
+
+		Ref      getRef(IndexT index) { return Ref { this, index, generation(index) }; }
+		ConstRef getRef(IndexT index) const { return ConstRef { this, index, generation(index) }; }
+
+		GenerationT generation(IndexT index) const { return index < m_Slots.size() ? m_Slots[index].m_Generation : 0; }
+
+		auto&       slots() const { return m_Slots; }
+		auto&       resources() const { return m_Resources; }
+		std::size_t size() const { return m_Resources.size(); }
+		bool        empty() const { return m_Resources.empty(); }
+
+		std::size_t allocatedSizeOf() const { return m_Slots.capacity() * sizeof(Slot) + m_FreeSlots.capacity() * sizeof(IndexT) + m_Resources.allocatedSizeOf(); }
+		std::size_t totalSizeOf() const { return sizeof(*this) + allocatedSizeOf(); }
+
+		auto begin() { return m_Resources.begin(); }
+		auto end() { return m_Resources.end(); }
+		auto begin() const { return m_Resources.begin(); }
+		auto end() const { return m_Resources.end(); }
+		auto cbegin() const { return m_Resources.cbegin(); }
+		auto cend() const { return m_Resources.cend(); }
+
+	private:
+		IndexT nextFreeSlot();
+
+	private:
+		SlotList     m_Slots;
+		ResourceList m_Resources;
+		// Vacated slots, entries taken through emplace are left in place and skipped when popped
+		std::vector<IndexT> m_FreeSlots;
+	};
+} // namespace ResourceManager
\ No newline at end of file
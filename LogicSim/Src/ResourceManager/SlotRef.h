@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ResourceManager
+{
+	template <class T, class IndexType>
+	struct SlotPool;
+
+	// Ref into a SlotPool, remembers the generation of the slot it was created from.
+	// valid() only tells whether the ref points into a pool at all, alive() also tells whether the resource still exists.
+	template <class T, class IndexType = std::size_t>
+	struct SlotRef
+	{
+	public:
+		using SlotPool    = SlotPool<T, IndexType>;
+		using IndexT      = IndexType;
+		using GenerationT = std::uint32_t;
+
+	public:
+		SlotRef();
+		SlotRef(SlotPool* pool, IndexT index, GenerationT generation);
+
+		inline bool valid() const;
+		inline bool alive() const;
+
+		inline T*       get();
+		inline const T* get() const;
+
+		SlotPool*       pool() { return m_Pool; }
+		const SlotPool* pool() const { return m_Pool; }
+		IndexT          index() const { return m_Index; }
+		GenerationT     generation() const { return m_Generation; }
+
+		         operator T&() { return *get(); }
+		         operator const T&() const { return *get(); }
+		T*       operator->() { return get(); }
+		const T* operator->() const { return get(); }
+		T&       operator*() { return *get(); }
+		const T& operator*() const { return *get(); }
+
+		friend bool operator==(SlotRef lhs, SlotRef rhs)
+		{
+			return lhs.m_Pool == rhs.m_Pool && lhs.m_Index == rhs.m_Index && lhs.m_Generation == rhs.m_Generation;
+		}
+		friend bool operator!=(SlotRef lhs, SlotRef rhs) { return !(lhs == rhs); }
+		friend bool operator<(SlotRef lhs, SlotRef rhs)
+		{
+			if (lhs.m_Pool != rhs.m_Pool)
+				return lhs.m_Pool < rhs.m_Pool;
+			if (lhs.m_Index != rhs.m_Index)
+				return lhs.m_Index < rhs.m_Index;
+			return lhs.m_Generation < rhs.m_Generation;
+		}
+		friend bool operator<=(SlotRef lhs, SlotRef rhs) { return !(rhs < lhs); }
+		friend bool operator>(SlotRef lhs, SlotRef rhs) { return rhs < lhs; }
+		friend bool operator>=(SlotRef lhs, SlotRef rhs) { return !(lhs < rhs); }
+
+	private:
+		SlotPool*   m_Pool;
+		IndexT      m_Index;
+		GenerationT m_Generation;
+	};
+
+	template <class T, class IndexType = std::size_t>
+	struct ConstSlotRef
+	{
+	public:
+		using SlotPool    = SlotPool<T, IndexType>;
+		using IndexT      = IndexType;
+		using GenerationT = std::uint32_t;
+
+	public:
+		ConstSlotRef();
+		ConstSlotRef(const SlotPool* pool, IndexT index, GenerationT generation);
+		ConstSlotRef(SlotRef<T, IndexType> ref);
+
+		inline bool valid() const;
+		inline bool alive() const;
+
+		inline const T* get() const;
+
+		const SlotPool* pool() const { return m_Pool; }
+		IndexT          index() const { return m_Index; }
+		GenerationT     generation() const { return m_Generation; }
+
+		         operator const T&() const { return *get(); }
+		const T* operator->() const { return get(); }
+		const T& operator*() const { return *get(); }
+
+		friend bool operator==(ConstSlotRef lhs, ConstSlotRef rhs)
+		{
+			return lhs.m_Pool == rhs.m_Pool && lhs.m_Index == rhs.m_Index && lhs.m_Generation == rhs.m_Generation;
+		}
+		friend bool operator!=(ConstSlotRef lhs, ConstSlotRef rhs) { return !(lhs == rhs); }
+		friend bool operator<(ConstSlotRef lhs, ConstSlotRef rhs)
+		{
+			if (lhs.m_Pool != rhs.m_Pool)
+				return lhs.m_Pool < rhs.m_Pool;
+			if (lhs.m_Index != rhs.m_Index)
+				return lhs.m_Index < rhs.m_Index;
+			return lhs.m_Generation < rhs.m_Generation;
+		}
+		friend bool operator<=(ConstSlotRef lhs, ConstSlotRef rhs) { return !(rhs < lhs); }
+		friend bool operator>(ConstSlotRef lhs, ConstSlotRef rhs) { return rhs < lhs; }
+		friend bool operator>=(ConstSlotRef lhs, ConstSlotRef rhs) { return !(lhs < rhs); }
+
+	private:
+		const SlotPool* m_Pool;
+		IndexT          m_Index;
+		GenerationT     m_Generation;
+	};
+} // namespace ResourceManager
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ResourceManager::Utils
+{
+	// Sequence stored in fixed size chunks of 1 << ChunkShift elements that are never reallocated.
+	// Growing only allocates a new chunk, so elements are never moved by growth and their addresses stay stable until they are erased or shifted by an insertion before them.
+	template <class T, std::size_t ChunkShift = 8>
+	struct ChunkedList
+	{
+	public:
+		static constexpr std::size_t c_ChunkSize = 1ULL << ChunkShift;
+		static constexpr std::size_t c_ChunkMask = c_ChunkSize - 1;
+
+		template <bool Const>
+		struct Iterator
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using iterator_concept  = std::random_access_iterator_tag;
+			using value_type        = T;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = std::conditional_t<Const, const T*, T*>;
+			using reference         = std::conditional_t<Const, const T&, T&>;
+			using List              = std::conditional_t<Const, const ChunkedList, ChunkedList>;
+
+		public:
+			Iterator() : m_List(nullptr), m_Index(0) {}
+			Iterator(List* list, std::size_t index) : m_List(list), m_Index(index) {}
+			template <bool OtherConst>
+			requires(Const && !OtherConst)
+			Iterator(Iterator<OtherConst> other) : m_List(other.list()), m_Index(other.index()) {}
+
+			List*       list() const { return m_List; }
+			std::size_t index() const { return m_Index; }
+
+			reference operator*() const { return (*m_List)[m_Index]; }
+			pointer   operator->() const { return &(*m_List)[m_Index]; }
+			reference operator[](difference_type offset) const { return (*m_List)[m_Index + offset]; }
+
+			Iterator& operator++()
+			{
+				++m_Index;
+				return *this;
+			}
+			Iterator operator++(int)
+			{
+				Iterator copy = *this;
+				++m_Index;
+				return copy;
+			}
+			Iterator& operator--()
+			{
+				--m_Index;
+				return *this;
+			}
+			Iterator operator--(int)
+			{
+				Iterator copy = *this;
+				--m_Index;
+				return copy;
+			}
+			Iterator& operator+=(difference_type offset)
+			{
+				m_Index += offset;
+				return *this;
+			}
+			Iterator& operator-=(difference_type offset)
+			{
+				m_Index -= offset;
+				return *this;
+			}
+
+			friend Iterator        operator+(Iterator it, difference_type offset) { return it += offset; }
+			friend Iterator        operator+(difference_type offset, Iterator it) { return it += offset; }
+			friend Iterator        operator-(Iterator it, difference_type offset) { return it -= offset; }
+			friend difference_type operator-(Iterator lhs, Iterator rhs) { return static_cast<difference_type>(lhs.m_Index) - static_cast<difference_type>(rhs.m_Index); }
+			friend bool            operator==(Iterator lhs, Iterator rhs) { return lhs.m_Index == rhs.m_Index; }
+			friend auto            operator<=>(Iterator lhs, Iterator rhs) { return lhs.m_Index <=> rhs.m_Index; }
+
+		private:
+			List*       m_List;
+			std::size_t m_Index;
+		};
+
+		using iterator       = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+	public:
+		ChunkedList() : m_Size(0) {}
+		ChunkedList(ChunkedList&& move) noexcept
+		    : m_Chunks(std::move(move.m_Chunks)),
+		      m_Size(move.m_Size)
+		{
+			move.m_Size = 0;
+		}
+		ChunkedList(const ChunkedList&) = delete;
+		~ChunkedList() { clear(); }
+
+		ChunkedList& operator=(ChunkedList&& move) noexcept
+		{
+			clear();
+			m_Chunks    = std::move(move.m_Chunks);
+			m_Size      = move.m_Size;
+			move.m_Size = 0;
+			return *this;
+		}
+		ChunkedList& operator=(const ChunkedList&) = delete;
+
+		template <class... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (m_Size == capacity())
+				m_Chunks.emplace_back(std::make_unique<Storage[]>(c_ChunkSize));
+			T* value = new (address(m_Size)) T(std::forward<Args>(args)...);
+			++m_Size;
+			return *value;
+		}
+
+		// Constructs at the back and rotates into place, every element after `pos` moves one step
+		template <class... Args>
+		iterator emplace(const_iterator pos, Args&&... args)
+		{
+			std::size_t index = pos.index();
+			emplace_back(std::forward<Args>(args)...);
+			std::rotate(begin() + index, end() - 1, end());
+			return begin() + index;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			std::size_t index = pos.index();
+			std::move(begin() + index + 1, end(), begin() + index);
+			pop_back();
+			return begin() + index;
+		}
+
+		void pop_back()
+		{
+			--m_Size;
+			std::destroy_at(address(m_Size));
+		}
+
+		void clear()
+		{
+			while (m_Size > 0)
+				pop_back();
+		}
+
+		void reserve(std::size_t count)
+		{
+			while (capacity() < count)
+				m_Chunks.emplace_back(std::make_unique<Storage[]>(c_ChunkSize));
+		}
+
+		void shrink_to_fit() { m_Chunks.resize((m_Size + c_ChunkMask) >> ChunkShift); }
+
+		T&       operator[](std::size_t index) { return *address(index); }
+		const T& operator[](std::size_t index) const { return *address(index); }
+		T&       back() { return *address(m_Size - 1); }
+		const T& back() const { return *address(m_Size - 1); }
+
+		std::size_t size() const { return m_Size; }
+		bool        empty() const { return m_Size == 0; }
+		std::size_t capacity() const { return m_Chunks.size() << ChunkShift; }
+		std::size_t chunkCount() const { return m_Chunks.size(); }
+
+		iterator       begin() { return { this, 0 }; }
+		iterator       end() { return { this, m_Size }; }
+		const_iterator begin() const { return { this, 0 }; }
+		const_iterator end() const { return { this, m_Size }; }
+		const_iterator cbegin() const { return { this, 0 }; }
+		const_iterator cend() const { return { this, m_Size }; }
+
+		std::size_t allocatedSizeOf() const { return m_Chunks.capacity() * sizeof(std::unique_ptr<Storage[]>) + capacity() * sizeof(T); }
+
+	private:
+		struct alignas(T) Storage
+		{
+		public:
+			std::byte m_Bytes[sizeof(T)];
+		};
+
+	private:
+		T*       address(std::size_t index) { return std::launder(reinterpret_cast<T*>(&m_Chunks[index >> ChunkShift][index & c_ChunkMask])); }
+		const T* address(std::size_t index) const { return std::launder(reinterpret_cast<const T*>(&m_Chunks[index >> ChunkShift][index & c_ChunkMask])); }
+
+	private:
+		std::vector<std::unique_ptr<Storage[]>> m_Chunks;
+		std::size_t                             m_Size;
+	};
+} // namespace ResourceManager::Utils
\ No newline at end of file
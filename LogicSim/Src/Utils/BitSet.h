@@ -4,228 +4,341 @@
 #include <cstdint>
 #include <cstring>
 
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <type_traits>
+
 struct BitReference
 {
 public:
-	BitReference() : m_Byte(nullptr), m_Bit(0), m_Mask(0) {}
-	BitReference(std::uint8_t* byte, std::uint8_t bit)
-	    : m_Byte(byte), m_Bit(bit), m_Mask(~(1 << bit)) {}
+	BitReference() : m_Word(nullptr), m_Bit(0) {}
+	BitReference(std::uint64_t* word, std::uint8_t bit)
+	    : m_Word(word), m_Bit(bit) {}
 
-	operator bool() const { return m_Byte ? (*m_Byte >> m_Bit) & 1 : false; }
+	operator bool() const { return m_Word ? (*m_Word >> m_Bit) & 1 : false; }
 
 	BitReference& operator=(bool value)
 	{
-		if (m_Byte)
-			*m_Byte = *m_Byte & m_Mask | value << m_Bit;
+		if (m_Word)
+			*m_Word = *m_Word & ~(1ULL << m_Bit) | static_cast<std::uint64_t>(value) << m_Bit;
 		return *this;
 	}
 
 private:
-	std::uint8_t* m_Byte;
-	std::uint8_t  m_Bit;
-	std::uint8_t  m_Mask;
+	std::uint64_t* m_Word;
+	std::uint8_t   m_Bit;
 };
 
-struct BitSet
+// Non owning view of `size` bits starting at bit `offset` of a word buffer, lets callers pass slices of their own storage without copying.
+// BitSpan writes through to the viewed words, ConstBitSpan only reads them.
+template <class Word>
+struct BasicBitSpan
 {
 public:
-	BitSet()
+	static constexpr std::size_t c_WordBits = 64;
+
+public:
+	BasicBitSpan()
 	    : m_Data(nullptr),
+	      m_Offset(0),
 	      m_Size(0) {}
+	BasicBitSpan(Word* data, std::size_t offset, std::size_t size)
+	    : m_Data(data),
+	      m_Offset(offset),
+	      m_Size(size) {}
+	template <class Other>
+	requires std::is_convertible_v<Other*, Word*>
+	BasicBitSpan(const BasicBitSpan<Other>& other)
+	    : m_Data(other.data()),
+	      m_Offset(other.offset()),
+	      m_Size(other.size()) {}
+
+	Word*       data() const { return m_Data; }
+	std::size_t offset() const { return m_Offset; }
+	std::size_t size() const { return m_Size; }
+	std::size_t wordCount() const { return (m_Offset + m_Size + c_WordBits - 1) / c_WordBits; }
+
+	bool get(std::size_t bit) const
+	{
+		if (bit >= m_Size)
+			return false;
+		bit += m_Offset;
+		return (m_Data[bit / c_WordBits] >> (bit % c_WordBits)) & 1;
+	}
+
+	void set(std::size_t bit, bool value) const
+	{
+		if (bit >= m_Size)
+			return;
+		bit += m_Offset;
+		std::uint64_t& word  = m_Data[bit / c_WordBits];
+		std::size_t    shift = bit % c_WordBits;
+		word                 = word & ~(1ULL << shift) | static_cast<std::uint64_t>(value) << shift;
+	}
+
+	bool operator[](std::size_t bit) const { return get(bit); }
+
+	// View of `count` bits starting at bit `start` of this view, clamped to its size
+	BasicBitSpan subspan(std::size_t start, std::size_t count = ~0ULL) const
+	{
+		start = std::min(start, m_Size);
+		return BasicBitSpan { m_Data, m_Offset + start, std::min(count, m_Size - start) };
+	}
+
+private:
+	Word*       m_Data;
+	std::size_t m_Offset;
+	std::size_t m_Size;
+};
+
+using BitSpan      = BasicBitSpan<std::uint64_t>;
+using ConstBitSpan = BasicBitSpan<const std::uint64_t>;
+
+// Fixed size set of bits stored in 64 bit words.
+// Bits past size() in the last word are always zero, so bulk operations can work on whole words.
+// Sets of up to c_InlineWords words live inside the object itself, so narrow port vectors never touch the heap.
+struct BitSet
+{
+public:
+	static constexpr std::size_t c_WordBits    = 64;
+	static constexpr std::size_t c_InlineWords = 2;
+	static constexpr std::size_t c_NoBit       = ~0ULL;
+
+	static constexpr std::size_t WordCount(std::size_t bits) { return (bits + c_WordBits - 1) / c_WordBits; }
+
+public:
+	BitSet()
+	    : m_Data(m_Inline),
+	      m_Size(0),
+	      m_Inline {} {}
 	BitSet(std::size_t initialSize)
-	    : m_Data(new std::uint8_t[(initialSize + 7) >> 3]),
-	      m_Size((initialSize + 7) >> 3 << 3)
+	    : m_Data(allocate(WordCount(initialSize))),
+	      m_Size(initialSize),
+	      m_Inline {}
 	{
-		std::memset(m_Data, 0, m_Size >> 3);
+		std::memset(m_Data, 0, wordCount() * sizeof(std::uint64_t));
 	}
 	BitSet(const std::initializer_list<std::uint8_t>& values)
-	    : m_Data(new std::uint8_t[values.size()]),
-	      m_Size(values.size() << 3)
+	    : BitSet(values.size() << 3)
 	{
 		std::size_t i = 0;
 		for (auto itr = values.begin(); itr != values.end(); ++itr, ++i)
-			m_Data[i] = *itr;
+			m_Data[i >> 3] |= static_cast<std::uint64_t>(*itr) << ((i & 0b111) << 3);
 	}
 	BitSet(const BitSet& copy)
-	    : m_Data(new std::uint8_t[copy.m_Size >> 3]),
-	      m_Size(copy.m_Size)
+	    : m_Data(allocate(copy.wordCount())),
+	      m_Size(copy.m_Size),
+	      m_Inline {}
 	{
-		std::memcpy(m_Data, copy.m_Data, m_Size >> 3);
+		std::memcpy(m_Data, copy.m_Data, wordCount() * sizeof(std::uint64_t));
 	}
 	BitSet(BitSet&& move) noexcept
-	    : m_Data(move.m_Data),
-	      m_Size(move.m_Size)
+	    : m_Data(move.isInline() ? m_Inline : move.m_Data),
+	      m_Size(move.m_Size),
+	      m_Inline {}
 	{
-		move.m_Data = nullptr;
+		if (move.isInline())
+			std::memcpy(m_Inline, move.m_Inline, sizeof(m_Inline));
+		move.m_Data = move.m_Inline;
 		move.m_Size = 0;
 	}
 	BitSet& operator=(const BitSet& copy)
 	{
-		if (m_Size < copy.m_Size)
-		{
-			delete[] m_Data;
-			m_Size = copy.m_Size;
-			m_Data = new std::uint8_t[m_Size >> 3];
-		}
-		else if (m_Size > copy.m_Size << 1)
+		if (this == &copy)
+			return *this;
+
+		if (wordCount() != copy.wordCount())
 		{
-			delete[] m_Data;
-			m_Size = copy.m_Size;
-			m_Data = new std::uint8_t[m_Size >> 3];
+			release();
+			m_Data = allocate(copy.wordCount());
 		}
-		std::memcpy(m_Data, copy.m_Data, m_Size >> 3);
+		m_Size = copy.m_Size;
+		std::memcpy(m_Data, copy.m_Data, wordCount() * sizeof(std::uint64_t));
 		return *this;
 	}
 	BitSet& operator=(BitSet&& move) noexcept
 	{
-		delete[] m_Data;
-		m_Data      = move.m_Data;
+		if (this == &move)
+			return *this;
+
+		release();
+		if (move.isInline())
+		{
+			m_Data = m_Inline;
+			std::memcpy(m_Inline, move.m_Inline, sizeof(m_Inline));
+		}
+		else
+		{
+			m_Data = move.m_Data;
+		}
 		m_Size      = move.m_Size;
-		move.m_Data = nullptr;
+		move.m_Data = move.m_Inline;
 		move.m_Size = 0;
 		return *this;
 	}
 	~BitSet()
 	{
-		delete[] m_Data;
+		release();
 	}
 
-	std::size_t size() const
-	{
-		return m_Size;
-	}
+	std::size_t size() const { return m_Size; }
+	std::size_t wordCount() const { return WordCount(m_Size); }
+
+	std::uint64_t*       data() { return m_Data; }
+	const std::uint64_t* data() const { return m_Data; }
 
 	void resize(std::size_t size)
 	{
-		std::size_t newSize = (size + 7) >> 3 << 3;
-		if (newSize != m_Size)
+		std::size_t newWords = WordCount(size);
+		if (newWords != wordCount())
 		{
-			std::uint8_t* newData   = new std::uint8_t[newSize >> 3];
-			std::size_t   copyCount = (newSize < m_Size ? newSize : m_Size) >> 3;
-			std::memcpy(newData, m_Data, copyCount);
-			if (newSize > m_Size)
-				std::memset(newData + copyCount, 0, (newSize >> 3) - copyCount);
-			delete[] m_Data;
+			std::uint64_t* newData   = allocate(newWords);
+			std::size_t    copyCount = std::min(newWords, wordCount());
+			if (newData != m_Data)
+				std::memcpy(newData, m_Data, copyCount * sizeof(std::uint64_t));
+			std::memset(newData + copyCount, 0, (newWords - copyCount) * sizeof(std::uint64_t));
+			if (newData != m_Data)
+				release();
 			m_Data = newData;
-			m_Size = newSize;
 		}
+		m_Size = size;
+		clearPadding();
 	}
 
 	bool get(std::size_t bit) const
 	{
-		std::size_t byteIndex = bit >> 3;
-		if (byteIndex >= m_Size)
+		if (bit >= m_Size)
 			return false;
-
-		std::uint8_t bitIndex = bit & 0b111;
-		return (m_Data[byteIndex] >> bitIndex) & 1;
+		return (m_Data[bit / c_WordBits] >> (bit % c_WordBits)) & 1;
 	}
 
 	void set(std::size_t bit, bool value)
 	{
-		std::size_t byteIndex = bit >> 3;
-		if (byteIndex >= m_Size)
+		if (bit >= m_Size)
 			return;
-		std::uint8_t bitIndex = bit & 0b111;
-		std::size_t  mask     = ~(1 << bitIndex);
-		m_Data[byteIndex]     = m_Data[byteIndex] & mask | static_cast<std::uint8_t>(value << bitIndex);
+		std::uint64_t& word  = m_Data[bit / c_WordBits];
+		std::size_t    shift = bit % c_WordBits;
+		word                 = word & ~(1ULL << shift) | static_cast<std::uint64_t>(value) << shift;
 	}
 
 	BitReference operator[](std::size_t bit)
 	{
-		std::size_t byteIndex = bit >> 3;
-		if (byteIndex >= m_Size)
+		if (bit >= m_Size)
 			return BitReference {};
-		std::uint8_t bitIndex = bit & 0b111;
-
-		return BitReference(m_Data + byteIndex, bitIndex);
+		return BitReference(m_Data + bit / c_WordBits, static_cast<std::uint8_t>(bit % c_WordBits));
 	}
 
 	bool operator[](std::size_t bit) const { return get(bit); }
 
-	void getBits(BitSet& result, std::size_t offset, std::size_t start, std::size_t count) const
+	operator BitSpan() { return BitSpan { m_Data, 0, m_Size }; }
+	operator ConstBitSpan() const { return ConstBitSpan { m_Data, 0, m_Size }; }
+
+	BitSpan      span(std::size_t start = 0, std::size_t count = ~0ULL) { return BitSpan(*this).subspan(start, count); }
+	ConstBitSpan span(std::size_t start = 0, std::size_t count = ~0ULL) const { return ConstBitSpan(*this).subspan(start, count); }
+
+	// Copies `count` bits starting at bit `start` of this set to bit `offset` of `result`, clamped to the size of both
+	void getBits(BitSpan result, std::size_t offset, std::size_t start, std::size_t count) const
 	{
-		std::size_t end = start + count;
-		if (end < start)
+		if (start >= m_Size || offset >= result.size())
 			return;
-		std::size_t startByte = start >> 3;
-		std::size_t endByte   = end >> 3;
-		if (startByte >= m_Size || endByte >= m_Size)
-			return;
-		std::size_t startBit = start & 0b111;
+		count = std::min({ count, m_Size - start, result.size() - offset });
+		CopyBits(result.data(), result.offset() + offset, m_Data, wordCount(), start, count);
+	}
 
-		if (result.m_Size < (offset + count))
-		{
-			if (offset & 0b111)
-			{
-				std::uint8_t startMask = (1 << (offset & 0b111)) - 1;
-				std::uint8_t endMask   = ~startMask;
-				result.m_Data[offset >> 3] &= startMask;
-				std::memset(result.m_Data + (offset >> 3) + 1, 0, ((result.m_Size - offset) >> 3) - 2);
-				result.m_Data[(result.m_Size >> 3) - 1] &= endMask;
-			}
-			else
-			{
-				std::memset(result.m_Data + (offset >> 3), 0, (result.m_Size - offset) >> 3);
-			}
+	// Copies `count` bits starting at bit `offset` of `values` to bit `start` of this set, clamped to the size of both
+	void setBits(ConstBitSpan values, std::size_t offset, std::size_t start, std::size_t count)
+	{
+		if (offset >= values.size() || start >= m_Size)
 			return;
-		}
+		count = std::min({ count, values.size() - offset, m_Size - start });
+		CopyBits(m_Data, start, values.data(), values.wordCount(), values.offset() + offset, count);
+	}
 
-		std::size_t i = offset >> 3, j = startByte + 1;
-		std::size_t resultBit  = offset & 0b111;
-		std::size_t resultMask = (1 << resultBit) - 1;
-		auto        writeValue = [&](std::uint8_t value, std::size_t readBits)
-		{
-			if (count > (8 - resultBit))
-			{
-				result.m_Data[i]     = result.m_Data[i] & resultMask | static_cast<std::uint8_t>(value << resultBit);
-				result.m_Data[i + 1] = value >> (8 - resultBit);
-			}
-			else if (resultBit == 0)
-			{
-				result.m_Data[i] = value;
-			}
-			else
-			{
-				result.m_Data[i] = result.m_Data[i] & resultMask | static_cast<std::uint8_t>(value << resultBit);
-			}
-
-			resultBit += readBits;
-			if (resultBit >= 8)
-			{
-				resultBit -= 8;
-				++i;
-			}
-			resultMask = (1 << resultBit) - 1;
-			count -= readBits;
-		};
-		if (count <= 8 - startBit)
-		{
-			std::uint8_t mask = (1 << count) - 1;
-			writeValue((m_Data[startByte] >> startBit) & mask, count);
-			return;
-		}
+	void fill(bool value)
+	{
+		std::memset(m_Data, value ? 0xFF : 0, wordCount() * sizeof(std::uint64_t));
+		clearPadding();
+	}
 
-		writeValue(m_Data[startByte] >> startBit, 8 - startBit);
+	BitSet& operator&=(const BitSet& other)
+	{
+		std::size_t common = std::min(wordCount(), other.wordCount());
+		for (std::size_t i = 0; i < common; ++i)
+			m_Data[i] &= other.m_Data[i];
+		std::memset(m_Data + common, 0, (wordCount() - common) * sizeof(std::uint64_t));
+		return *this;
+	}
 
-		for (; count > 8; ++j)
-			writeValue(m_Data[j], 8);
+	BitSet& operator|=(const BitSet& other)
+	{
+		std::size_t common = std::min(wordCount(), other.wordCount());
+		for (std::size_t i = 0; i < common; ++i)
+			m_Data[i] |= other.m_Data[i];
+		clearPadding();
+		return *this;
+	}
 
-		if (count > 0)
-		{
-			std::uint8_t mask = (1 << count) - 1;
-			writeValue(m_Data[j] & mask, count);
-		}
+	BitSet& operator^=(const BitSet& other)
+	{
+		std::size_t common = std::min(wordCount(), other.wordCount());
+		for (std::size_t i = 0; i < common; ++i)
+			m_Data[i] ^= other.m_Data[i];
+		clearPadding();
+		return *this;
 	}
 
-	void setBits(const BitSet& values, std::size_t offset, std::size_t start, std::size_t count)
+	// Inverts every bit in place
+	void flip()
 	{
-		values.getBits(*this, start, offset, count);
+		for (std::size_t i = 0; i < wordCount(); ++i)
+			m_Data[i] = ~m_Data[i];
+		clearPadding();
 	}
 
+	bool operator==(const BitSet& other) const
+	{
+		return m_Size == other.m_Size && std::memcmp(m_Data, other.m_Data, wordCount() * sizeof(std::uint64_t)) == 0;
+	}
+
+	std::size_t popcount() const
+	{
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < wordCount(); ++i)
+			count += std::popcount(m_Data[i]);
+		return count;
+	}
+
+	bool any() const
+	{
+		for (std::size_t i = 0; i < wordCount(); ++i)
+			if (m_Data[i])
+				return true;
+		return false;
+	}
+
+	// Index of the first set bit at or after `from`, c_NoBit if there is none
+	std::size_t findFirstSet(std::size_t from = 0) const
+	{
+		if (from >= m_Size)
+			return c_NoBit;
+
+		std::size_t   i    = from / c_WordBits;
+		std::uint64_t word = m_Data[i] & (~0ULL << (from % c_WordBits));
+		while (!word)
+		{
+			if (++i >= wordCount())
+				return c_NoBit;
+			word = m_Data[i];
+		}
+		return i * c_WordBits + std::countr_zero(word);
+	}
+
+	bool isInline() const { return m_Data == m_Inline; }
+
 	std::size_t allocatedSizeOf() const
 	{
-		return m_Size;
+		return isInline() ? 0 : wordCount() * sizeof(std::uint64_t);
 	}
 
 	std::size_t totalSizeOf() const
@@ -234,6 +347,49 @@ public:
 	}
 
 private:
-	std::uint8_t* m_Data;
-	std::size_t   m_Size;
+	std::uint64_t* allocate(std::size_t words)
+	{
+		return words <= c_InlineWords ? m_Inline : new std::uint64_t[words];
+	}
+
+	void release()
+	{
+		if (!isInline())
+			delete[] m_Data;
+		m_Data = m_Inline;
+	}
+
+	// Copies `count` bits from bit `sourceBit` of `source` to bit `destinationBit` of `destination`, moving up to a word per step
+	static void CopyBits(std::uint64_t* destination, std::size_t destinationBit, const std::uint64_t* source, std::size_t sourceWords, std::size_t sourceBit, std::size_t count)
+	{
+		while (count > 0)
+		{
+			std::size_t   sourceWord  = sourceBit / c_WordBits;
+			std::size_t   sourceShift = sourceBit % c_WordBits;
+			std::uint64_t value       = source[sourceWord] >> sourceShift;
+			if (sourceShift != 0 && sourceWord + 1 < sourceWords)
+				value |= source[sourceWord + 1] << (c_WordBits - sourceShift);
+
+			std::size_t    destinationShift = destinationBit % c_WordBits;
+			std::size_t    bits             = std::min(count, c_WordBits - destinationShift);
+			std::uint64_t  mask             = (bits == c_WordBits ? ~0ULL : (1ULL << bits) - 1) << destinationShift;
+			std::uint64_t& word             = destination[destinationBit / c_WordBits];
+			word                            = word & ~mask | (value << destinationShift) & mask;
+
+			sourceBit += bits;
+			destinationBit += bits;
+			count -= bits;
+		}
+	}
+
+	void clearPadding()
+	{
+		if (m_Size % c_WordBits)
+			m_Data[m_Size / c_WordBits] &= (1ULL << (m_Size % c_WordBits)) - 1;
+	}
+
+private:
+	std::uint64_t* m_Data; // Points at m_Inline while the bits fit
+	std::size_t    m_Size;
+	std::uint64_t  m_Inline[c_InlineWords];
 };
\ No newline at end of file
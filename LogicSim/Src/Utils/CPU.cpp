@@ -0,0 +1,62 @@
+#include "CPU.h"
+#include "Core.h"
+
+#if BUILD_IS_PLATFORM_AMD64 && BUILD_IS_TOOLSET_MSVC
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace CPU
+{
+	struct Features
+	{
+	public:
+		Features()
+		    : m_AVX2(false),
+		      m_AVX512(false)
+		{
+#if BUILD_IS_PLATFORM_AMD64
+#if BUILD_IS_TOOLSET_MSVC
+			int info[4] {};
+			__cpuid(info, 0);
+			int maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			bool osxsave = (info[2] >> 27) & 1;
+			bool avx     = (info[2] >> 28) & 1;
+			if (!osxsave || !avx || maxLeaf < 7)
+				return;
+
+			unsigned long long xcr0 = _xgetbv(0);
+			__cpuidex(info, 7, 0);
+			m_AVX2   = (xcr0 & 0x6) == 0x6 && ((info[1] >> 5) & 1);
+			m_AVX512 = (xcr0 & 0xE6) == 0xE6 && ((info[1] >> 16) & 1);
+#else
+			__builtin_cpu_init();
+			m_AVX2   = __builtin_cpu_supports("avx2");
+			m_AVX512 = __builtin_cpu_supports("avx512f");
+#endif
+#endif
+		}
+
+	public:
+		bool m_AVX2;
+		bool m_AVX512;
+	};
+
+	static const Features& GetFeatures()
+	{
+		static Features s_Features;
+		return s_Features;
+	}
+
+	bool HasAVX2()
+	{
+		return GetFeatures().m_AVX2;
+	}
+
+	bool HasAVX512()
+	{
+		return GetFeatures().m_AVX512;
+	}
+} // namespace CPU
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace CPU
+{
+	// Instruction set extensions supported by both the processor and the operating system
+	bool HasAVX2();
+	bool HasAVX512();
+} // namespace CPU
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "ThreadPool.h"
+
+#include <cassert>
+
+// Iterations a worker polls for the next loop before blocking, keeps the barrier between short back to back loops cheap
+static constexpr std::size_t c_SpinCount = 4096;
+
+static std::uint64_t PackRange(std::size_t begin, std::size_t end)
+{
+	return static_cast<std::uint64_t>(begin) | static_cast<std::uint64_t>(end) << 32;
+}
+
+std::size_t ThreadPool::DefaultThreadCount()
+{
+	std::size_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : m_Ranges(std::make_unique<WorkerRange[]>(threadCount + 1)),
+      m_Generation(0),
+      m_Remaining(0),
+      m_Stop(false),
+      m_Task(nullptr),
+      m_Context(nullptr),
+      m_Count(0),
+      m_Grain(0)
+{
+	m_Threads.reserve(threadCount);
+	for (std::size_t i = 0; i < threadCount; ++i)
+		m_Threads.emplace_back(&ThreadPool::workerMain, this, i + 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock { m_Mutex };
+		m_Stop.store(true, std::memory_order_release);
+	}
+	m_Wake.notify_all();
+	for (auto& thread : m_Threads)
+		thread.join();
+}
+
+void ThreadPool::run(std::size_t count, std::size_t grain, Task task, void* context)
+{
+	if (m_Threads.empty() || count < 2 || (grain != 0 && count <= grain))
+	{
+		task(context, 0, count, 0);
+		return;
+	}
+
+	// Ranges are packed as two 32 bit halves, see PackRange
+	assert(count < (1ULL << 32));
+
+	{
+		std::lock_guard lock { m_Mutex };
+		m_Task    = task;
+		m_Context = context;
+		m_Count   = count;
+		m_Grain   = grain;
+		if (grain != 0)
+		{
+			for (std::size_t worker = 0; worker < workerCount(); ++worker)
+				m_Ranges[worker].m_Range.store(PackRange(chunkBegin(worker), chunkBegin(worker + 1)), std::memory_order_relaxed);
+		}
+		m_Remaining.store(m_Threads.size(), std::memory_order_relaxed);
+		m_Generation.fetch_add(1, std::memory_order_release);
+	}
+	m_Wake.notify_all();
+
+	execute(0);
+	while (m_Remaining.load(std::memory_order_acquire) != 0)
+		std::this_thread::yield();
+}
+
+void ThreadPool::workerMain(std::size_t worker)
+{
+	std::uint64_t generation = 0;
+	while (true)
+	{
+		for (std::size_t i = 0; i < c_SpinCount && m_Generation.load(std::memory_order_acquire) == generation && !m_Stop.load(std::memory_order_acquire); ++i)
+			std::this_thread::yield();
+
+		if (m_Generation.load(std::memory_order_acquire) == generation)
+		{
+			std::unique_lock lock { m_Mutex };
+			m_Wake.wait(lock, [this, generation]() { return m_Stop.load(std::memory_order_acquire) || m_Generation.load(std::memory_order_acquire) != generation; });
+		}
+		if (m_Stop.load(std::memory_order_acquire))
+			return;
+
+		generation = m_Generation.load(std::memory_order_acquire);
+		execute(worker);
+		m_Remaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
+
+void ThreadPool::execute(std::size_t worker)
+{
+	if (m_Grain == 0)
+	{
+		std::size_t begin = chunkBegin(worker);
+		std::size_t end   = chunkBegin(worker + 1);
+		if (begin != end)
+			m_Task(m_Context, begin, end, worker);
+		return;
+	}
+
+	std::size_t begin, end;
+	do
+	{
+		while (pop(worker, begin, end))
+			m_Task(m_Context, begin, end, worker);
+	}
+	while (steal(worker));
+}
+
+bool ThreadPool::pop(std::size_t worker, std::size_t& begin, std::size_t& end)
+{
+	auto&         range = m_Ranges[worker].m_Range;
+	std::uint64_t value = range.load(std::memory_order_acquire);
+	while (true)
+	{
+		std::size_t first = value & 0xFFFF'FFFF;
+		std::size_t last  = value >> 32;
+		if (first >= last)
+			return false;
+
+		std::size_t next = std::min(first + m_Grain, last);
+		if (range.compare_exchange_weak(value, PackRange(next, last), std::memory_order_acq_rel))
+		{
+			begin = first;
+			end   = next;
+			return true;
+		}
+	}
+}
+
+bool ThreadPool::steal(std::size_t worker)
+{
+	for (std::size_t i = 1; i < workerCount(); ++i)
+	{
+		auto&         range = m_Ranges[(worker + i) % workerCount()].m_Range;
+		std::uint64_t value = range.load(std::memory_order_acquire);
+		while (true)
+		{
+			std::size_t first = value & 0xFFFF'FFFF;
+			std::size_t last  = value >> 32;
+			if (first >= last)
+				break;
+
+			// Take the upper half, or everything when only a single chunk is left
+			std::size_t middle = last - first > m_Grain ? first + (last - first) / 2 : first;
+			if (range.compare_exchange_weak(value, PackRange(first, middle), std::memory_order_acq_rel))
+			{
+				m_Ranges[worker].m_Range.store(PackRange(middle, last), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads for fork-join loops.
+// Both loop forms let the calling thread take part as worker 0 and return once the whole range is done,
+// so consecutive calls act as a barrier between them. Only one thread may start loops on a pool at a time.
+struct ThreadPool
+{
+public:
+	// Hardware threads minus the calling thread
+	static std::size_t DefaultThreadCount();
+
+public:
+	ThreadPool(std::size_t threadCount = DefaultThreadCount());
+	ThreadPool(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Calls function(begin, end, worker) once per worker with disjoint contiguous chunks covering [0, count), `worker` is below workerCount()
+	template <class F>
+	void parallelFor(std::size_t count, F&& function)
+	{
+		run(count, 0, &Invoke<std::remove_reference_t<F>>, const_cast<void*>(static_cast<const void*>(&function)));
+	}
+
+	// Calls function(begin, end, worker) for chunks of at most `grain` indices covering [0, count).
+	// Every worker starts on its own share of the range and steals half of another worker's remainder once it runs dry, for uneven work per index
+	template <class F>
+	void parallelForDynamic(std::size_t count, std::size_t grain, F&& function)
+	{
+		run(count, std::max<std::size_t>(grain, 1), &Invoke<std::remove_reference_t<F>>, const_cast<void*>(static_cast<const void*>(&function)));
+	}
+
+	std::size_t workerCount() const { return m_Threads.size() + 1; }
+
+private:
+	using Task = void (*)(void* context, std::size_t begin, std::size_t end, std::size_t worker);
+
+	template <class F>
+	static void Invoke(void* context, std::size_t begin, std::size_t end, std::size_t worker)
+	{
+		(*static_cast<F*>(context))(begin, end, worker);
+	}
+
+	// Remaining range of a worker packed as begin | end << 32, so the owner and thieves claim indices with a single compare exchange
+	struct alignas(64) WorkerRange
+	{
+	public:
+		std::atomic<std::uint64_t> m_Range;
+	};
+
+	void run(std::size_t count, std::size_t grain, Task task, void* context);
+	void workerMain(std::size_t worker);
+	void execute(std::size_t worker);
+
+	bool pop(std::size_t worker, std::size_t& begin, std::size_t& end);
+	bool steal(std::size_t worker);
+
+	std::size_t chunkBegin(std::size_t worker) const { return m_Count * worker / workerCount(); }
+
+private:
+	std::vector<std::thread>       m_Threads;
+	std::unique_ptr<WorkerRange[]> m_Ranges;
+
+	std::mutex              m_Mutex;
+	std::condition_variable m_Wake;
+
+	std::atomic<std::uint64_t> m_Generation;
+	std::atomic<std::size_t>   m_Remaining;
+	std::atomic<bool>          m_Stop;
+
+	Task        m_Task;
+	void*       m_Context;
+	std::size_t m_Count;
+	std::size_t m_Grain;
+};
\ No newline at end of file